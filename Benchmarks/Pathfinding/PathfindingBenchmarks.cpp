@@ -0,0 +1,185 @@
+#include "../../Source/Pathfinding/FlowField.h"
+#include "../../Source/Pathfinding/GridPathfinder.h"
+#include "../../Source/Pathfinding/HierarchicalGraph.h"
+#include "../../Source/Pathfinding/PathCache.h"
+#include "../../Source/Pathfinding/WalkabilityGrid.h"
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+// Count every allocation, so that searches can be checked for allocating once warmed up.
+namespace
+{
+	std::atomic<size_t> AllocationCount = 0;
+}
+
+void* operator new(size_t size)
+{
+	++AllocationCount;
+	if (void* memory = std::malloc(size)) { return memory; }
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+namespace Engine
+{
+	namespace
+	{
+		/// <summary>
+		/// A generated map along with the queries to run on it, both the same on every run.
+		/// </summary>
+		struct Map
+		{
+			WalkabilityGrid Grid;
+			HierarchicalGraph Hierarchy;
+			std::vector<std::pair<Vector2<int>, Vector2<int>>> Queries; // Start and goal, always with a path between.
+		};
+
+		/// <summary>
+		/// Build a square map centred on the origin, as the navigation graph bakes, with a percentage of its cells
+		/// blocked by walls. Built once per size and density, outside of any timing.
+		/// </summary>
+		const Map& GetMap(int size, int density)
+		{
+			static std::map<std::pair<int, int>, Map> maps;
+			auto [existing, isAdded] = maps.try_emplace({ size, density });
+			Map& map = existing->second;
+			if (!isAdded) { return map; }
+
+			std::mt19937 random(size * 100 + density);
+			map.Grid.Resize({ -size / 2, -size / 2 }, { size, size }, WalkabilityGrid::AllDirections);
+
+			// Short walls rather than scattered cells, so there's something to path around.
+			const size_t wallCount = map.Grid.GetCellCount() * density / 100 / 8;
+			for (size_t wall = 0; wall < wallCount; ++wall)
+			{
+				Vector2<int> cell = map.Grid.GetCell(random() % map.Grid.GetCellCount());
+				const Vector2<int> step = random() % 2 ? Vector2<int>{ 1, 0 } : Vector2<int>{ 0, 1 };
+				for (int i = 0; i < 8; ++i, cell += step) { map.Grid.BlockCell(cell); }
+			}
+			map.Hierarchy.Build(map.Grid);
+
+			// Queries from one side of the map to the other, where the ends are connected.
+			GridPathfinder pathfinder;
+			std::vector<Vector2<int>> path;
+			while (map.Queries.size() < 64)
+			{
+				const Vector2<int> start = { -size / 2 + static_cast<int>(random() % (size / 4)), -size / 2 + static_cast<int>(random() % size) };
+				const Vector2<int> goal = { size / 2 - 1 - static_cast<int>(random() % (size / 4)), -size / 2 + static_cast<int>(random() % size) };
+				if (pathfinder.AStar(map.Grid, start, goal, path)) { map.Queries.emplace_back(start, goal); }
+			}
+
+			return map;
+		}
+
+		/// <summary>
+		/// Run a search per iteration, cycling through the map's queries, and report the averages per query. Every query
+		/// is run once first without being timed or counted, so buffers the search keeps are already allocated.
+		/// </summary>
+		/// <param name="search">Runs a query, returning how many nodes it expanded.</param>
+		/// <param name="isCountingExpanded">False if the search can't tell how many nodes it expanded.</param>
+		template <typename Search>
+		void RunQueries(benchmark::State& state, Search search, bool isCountingExpanded = true)
+		{
+			const Map& map = GetMap(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+
+			for (const auto& [start, goal] : map.Queries) { search(map, start, goal); }
+
+			// Allocations are only counted around the search itself, so the benchmark's own aren't counted too.
+			size_t query = 0;
+			size_t expandedCount = 0;
+			size_t allocationCount = 0;
+			for (auto _ : state)
+			{
+				const auto& [start, goal] = map.Queries[query++ % map.Queries.size()];
+				const size_t allocationsBefore = AllocationCount;
+				expandedCount += search(map, start, goal);
+				allocationCount += AllocationCount - allocationsBefore;
+			}
+
+			if (isCountingExpanded)
+			{
+				state.counters["Expanded"] = benchmark::Counter(static_cast<double>(expandedCount), benchmark::Counter::kAvgIterations);
+			}
+			state.counters["Allocations"] = benchmark::Counter(static_cast<double>(allocationCount), benchmark::Counter::kAvgIterations);
+		}
+
+		void AddMapArguments(benchmark::internal::Benchmark* benchmark)
+		{
+			benchmark->ArgsProduct({ { 64, 128, 256 }, { 0, 10, 25 } })->ArgNames({ "Size", "Density" });
+		}
+	}
+
+	void BM_FlowFieldBuild(benchmark::State& state)
+	{
+		// A flow field searches out from the goal over every cell that can reach it.
+		FlowField field;
+		RunQueries(state, [&field](const Map& map, Vector2<int> start, Vector2<int> goal)
+		{
+			field.Build(map.Grid, goal);
+			benchmark::DoNotOptimize(field.GetDistance(start));
+			return field.GetReachedCount();
+		});
+	}
+	BENCHMARK(BM_FlowFieldBuild)->Apply(AddMapArguments);
+
+	void BM_AStar(benchmark::State& state)
+	{
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+		RunQueries(state, [&](const Map& map, Vector2<int> start, Vector2<int> goal)
+		{
+			benchmark::DoNotOptimize(pathfinder.AStar(map.Grid, start, goal, path));
+			return pathfinder.GetExpandedCount();
+		});
+	}
+	BENCHMARK(BM_AStar)->Apply(AddMapArguments);
+
+	void BM_JumpPointSearch(benchmark::State& state)
+	{
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+		RunQueries(state, [&](const Map& map, Vector2<int> start, Vector2<int> goal)
+		{
+			benchmark::DoNotOptimize(pathfinder.JumpPointSearch(map.Grid, start, goal, path));
+			return pathfinder.GetExpandedCount();
+		});
+	}
+	BENCHMARK(BM_JumpPointSearch)->Apply(AddMapArguments);
+
+	void BM_HierarchicalSearch(benchmark::State& state)
+	{
+		std::vector<Vector2<int>> path;
+		RunQueries(state, [&path](const Map& map, Vector2<int> start, Vector2<int> goal)
+		{
+			benchmark::DoNotOptimize(map.Hierarchy.FindPath(map.Grid, start, goal, path));
+			return size_t(0);
+		}, false);
+	}
+	BENCHMARK(BM_HierarchicalSearch)->Apply(AddMapArguments);
+
+	void BM_CachedSearch(benchmark::State& state)
+	{
+		// Every query is searched by the untimed first run, then looked up from then on, as the editor's path to the
+		// mouse is.
+		GridPathfinder pathfinder;
+		PathCache cache;
+		std::vector<Vector2<int>> path;
+		RunQueries(state, [&](const Map& map, Vector2<int> start, Vector2<int> goal)
+		{
+			if (cache.Find(start, goal, 0, path)) { return size_t(0); }
+
+			pathfinder.AStar(map.Grid, start, goal, path);
+			cache.Insert(start, goal, 0, path);
+			return pathfinder.GetExpandedCount();
+		});
+	}
+	BENCHMARK(BM_CachedSearch)->Apply(AddMapArguments);
+}
@@ -0,0 +1,95 @@
+#include "../../Source/Maths/RadixSort.h"
+#include "../../Source/SceneManagement/DepthKey.h"
+#include "../../Source/SceneManagement/RenderList.h"
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include "../../Source/EntityComponentSystem/Components.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace Engine
+{
+	namespace
+	{
+		/// <summary>
+		/// Tiles over a few layers, as a map's would be, in no particular order. The same on every run.
+		/// </summary>
+		std::vector<Position> GetPositions(size_t count)
+		{
+			std::mt19937 random(static_cast<unsigned>(count));
+			std::vector<Position> positions(count);
+			for (Position& position : positions)
+			{
+				position = { { static_cast<float>(random() % 4096), static_cast<float>(random() % 4096) }, static_cast<int>(random() % 3) };
+			}
+			return positions;
+		}
+
+		void AddSizeArguments(benchmark::internal::Benchmark* benchmark)
+		{
+			benchmark->Arg(1000)->Arg(10000)->Arg(100000)->ArgName("Count");
+		}
+	}
+
+	void BM_ComparisonDepthSort(benchmark::State& state)
+	{
+		const std::vector<Position> positions = GetPositions(static_cast<size_t>(state.range(0)));
+		std::vector<Position> sorted;
+		for (auto _ : state)
+		{
+			sorted = positions;
+			std::sort(sorted.begin(), sorted.end(), [](const Position& a, const Position& b) { return a.Z != b.Z ? a.Z < b.Z : a.Y < b.Y; });
+			benchmark::DoNotOptimize(sorted.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_ComparisonDepthSort)->Apply(AddSizeArguments);
+
+	void BM_RadixDepthSort(benchmark::State& state)
+	{
+		const std::vector<Position> positions = GetPositions(static_cast<size_t>(state.range(0)));
+		std::vector<uint64_t> keys;
+		std::vector<uint64_t> buffer;
+		std::vector<Position> sorted;
+		for (auto _ : state)
+		{
+			// Includes packing and gathering, as RenderList::SortAll has to.
+			keys.clear();
+			for (size_t i = 0; i < positions.size(); ++i) { keys.push_back(DepthKey::Pack(positions[i].Z, positions[i].Y, i)); }
+			RadixSort(keys, buffer);
+			sorted.clear();
+			for (uint64_t key : keys) { sorted.push_back(positions[DepthKey::GetIndex(key)]); }
+			benchmark::DoNotOptimize(sorted.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_RadixDepthSort)->Apply(AddSizeArguments);
+
+	void BM_RenderListUpdate(benchmark::State& state)
+	{
+		// A map of static tiles with a handful of characters walking about.
+		EntityManager entityManager;
+		RenderList list;
+		std::vector<Entity> moving;
+		for (const Position& position : GetPositions(static_cast<size_t>(state.range(0))))
+		{
+			Entity entity = entityManager.AddEntity("Rendered");
+			entity.AddComponent<Position>() = position;
+			entity.AddComponent<Sprite>();
+			if (moving.size() < 8) { moving.push_back(entity); }
+		}
+		entityManager.Update();
+		list.Update(entityManager);
+
+		for (auto _ : state)
+		{
+			for (Entity entity : moving) { entity.GetComponent<Position>().Y += 1.f; }
+			entityManager.Update();
+			list.Update(entityManager);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		entityManager.Clear();
+	}
+	BENCHMARK(BM_RenderListUpdate)->Apply(AddSizeArguments);
+}
@@ -0,0 +1,136 @@
+#include "SpatialHash.h"
+#include "../EntityComponentSystem/EntityManager.h"
+#include "../EntityComponentSystem/Components.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine
+{
+	SpatialHash::SpatialHash(float cellSize) : CellSize(cellSize) {}
+
+	Vector2<int> SpatialHash::GetCellCoordinates(Vector2<float> position) const
+	{
+		return { static_cast<int>(std::floor(position.X / CellSize)), static_cast<int>(std::floor(position.Y / CellSize)) };
+	}
+
+	uint64_t SpatialHash::GetCellKey(Vector2<int> cell)
+	{
+		return (uint64_t(uint32_t(cell.X)) << 32) | uint32_t(cell.Y);
+	}
+
+	void SpatialHash::Insert(Entity entity, Vector2<float> position)
+	{
+		Entry& entry = Entries[entity.GetID()];
+		const uint64_t cell = GetCellKey(GetCellCoordinates(position));
+
+		// Still in the same cell, so only the cached position needs updating.
+		if (entry.IsTracked && entry.Generation == entity.GetGeneration() && entry.Cell == cell)
+		{
+			Cells[cell][entry.Index].Position = position;
+			return;
+		}
+
+		// Either moved cell or the ID has been reused since it was added.
+		if (entry.IsTracked) { Remove(entity.GetID()); }
+
+		std::vector<Item>& items = Cells[cell];
+		entry = { cell, static_cast<uint32_t>(items.size()), entity.GetGeneration(), true };
+		items.push_back({ entity, position });
+		++TrackedCount;
+	}
+
+	void SpatialHash::Remove(size_t id)
+	{
+		Entry& entry = Entries[id];
+		auto cell = Cells.find(entry.Cell);
+
+		// Swap and pop, fixing up the index of the item that was moved.
+		std::vector<Item>& items = cell->second;
+		items[entry.Index] = items.back();
+		Entries[items[entry.Index].Owner.GetID()].Index = entry.Index;
+		items.pop_back();
+		if (items.empty()) { Cells.erase(cell); }
+
+		entry = {};
+		--TrackedCount;
+	}
+
+	void SpatialHash::Update(EntityManager& entityManager)
+	{
+		EntityMemoryPool& pool = EntityMemoryPool::Instance();
+		if (Entries.size() < pool.GetCapacity()) { Entries.resize(pool.GetCapacity()); }
+
+		// Changes are stamped with the tick they happen on, so changes made after the last update but on the same tick
+		// are included, at the cost of re-checking some that were already handled.
+		for (Entity entity : entityManager.GetView<Changed<Position>>(LastUpdateTick))
+		{
+			const Position& position = entity.ReadComponent<Position>();
+			Insert(entity, { position.X, position.Y });
+		}
+		LastUpdateTick = pool.GetTick();
+
+		// Every entity with a position is tracked, so any more than that means some have been destroyed or lost their
+		// position. Only then is it worth looking through everything for them.
+		if (TrackedCount <= entityManager.GetView<Position>().size()) { return; }
+
+		for (size_t id = 0; id < Entries.size(); ++id)
+		{
+			const Entry& entry = Entries[id];
+			if (entry.IsTracked && (!pool.IsValid(id, entry.Generation) || !pool.HasComponent<Position>(id))) { Remove(id); }
+		}
+	}
+
+	void SpatialHash::SetCellSize(float cellSize)
+	{
+		std::vector<Item> items;
+		items.reserve(TrackedCount);
+		for (const auto& [key, cellItems] : Cells) { items.insert(items.end(), cellItems.begin(), cellItems.end()); }
+
+		Clear();
+		CellSize = cellSize;
+		for (const Item& item : items) { Insert(item.Owner, item.Position); }
+	}
+
+	void SpatialHash::Clear()
+	{
+		Cells.clear();
+		std::fill(Entries.begin(), Entries.end(), Entry{});
+		TrackedCount = 0;
+	}
+
+	std::vector<Entity> SpatialHash::QueryRectangle(Rectangle<float> area) const
+	{
+		std::vector<Entity> entities;
+		ForEachInArea(area, [&entities, &area](const Item& item)
+		{
+			if (item.Position.X >= area.Position.X && item.Position.X <= area.Position.X + area.Size.X
+				&& item.Position.Y >= area.Position.Y && item.Position.Y <= area.Position.Y + area.Size.Y)
+			{
+				entities.push_back(item.Owner);
+			}
+		});
+		return entities;
+	}
+
+	std::vector<Entity> SpatialHash::QueryRadius(Vector2<float> centre, float radius) const
+	{
+		std::vector<Entity> entities;
+		const Rectangle<float> area = { centre - Vector2<float>{ radius, radius }, Vector2<float>{ radius, radius } * 2 };
+		ForEachInArea(area, [&entities, centre, radius](const Item& item)
+		{
+			if ((item.Position - centre).LengthSquared() <= radius * radius) { entities.push_back(item.Owner); }
+		});
+		return entities;
+	}
+
+	std::vector<Entity> SpatialHash::QueryPoint(Vector2<float> point) const
+	{
+		auto cell = Cells.find(GetCellKey(GetCellCoordinates(point)));
+		if (cell == Cells.end()) { return {}; }
+
+		std::vector<Entity> entities;
+		entities.reserve(cell->second.size());
+		for (const Item& item : cell->second) { entities.push_back(item.Owner); }
+		return entities;
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "../Maths/Vector2.h"
+#include "../Maths/Rectangle.h"
+#include "../EntityComponentSystem/Entity.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+	class EntityManager;
+
+	/// <summary>
+	/// Buckets every entity with a <see cref="Position"/> into a uniform grid of world space cells, so that finding the
+	/// entities near a point scales with how many are nearby rather than how many there are in total.
+	/// </summary>
+	/// <remarks>
+	/// Kept up to date by <see cref="Update"/>, which only looks at entities whose position changed since the last call.
+	/// Positions are cached when updated so that queries don't read components other threads might be writing, and
+	/// queries are safe to make from several threads at once as long as no update is running.
+	/// </remarks>
+	class SpatialHash
+	{
+		struct Item
+		{
+			Entity Owner;
+			Vector2<float> Position;
+		};
+
+		/// <summary>
+		/// Where an entity ID is in the cells, so it can be moved or removed with a swap and pop.
+		/// </summary>
+		struct Entry
+		{
+			uint64_t Cell = 0;
+			uint32_t Index = 0;
+			uint32_t Generation = 0;
+			bool IsTracked = false;
+		};
+
+		float CellSize;
+		std::unordered_map<uint64_t, std::vector<Item>> Cells;
+		std::vector<Entry> Entries; // Indexed by entity ID.
+		size_t TrackedCount = 0;
+		uint32_t LastUpdateTick = 0;
+
+		Vector2<int> GetCellCoordinates(Vector2<float> position) const;
+		static uint64_t GetCellKey(Vector2<int> cell);
+
+		void Insert(Entity entity, Vector2<float> position);
+		void Remove(size_t id);
+
+		/// <summary>
+		/// Call function with every item in the cells overlapping the area.
+		/// </summary>
+		template<typename F>
+		void ForEachInArea(Rectangle<float> area, F&& function) const
+		{
+			const Vector2<int> first = GetCellCoordinates(area.Position);
+			const Vector2<int> last = GetCellCoordinates(area.Position + area.Size);
+
+			// When the area covers more cells than are occupied it's quicker to check the occupied ones.
+			const uint64_t areaCellCount = uint64_t(last.X - first.X + 1) * uint64_t(last.Y - first.Y + 1);
+			if (areaCellCount > Cells.size())
+			{
+				for (const auto& [key, items] : Cells)
+				{
+					for (const Item& item : items) { function(item); }
+				}
+				return;
+			}
+
+			for (int x = first.X; x <= last.X; ++x)
+			{
+				for (int y = first.Y; y <= last.Y; ++y)
+				{
+					auto cell = Cells.find(GetCellKey({ x, y }));
+					if (cell == Cells.end()) { continue; }
+
+					for (const Item& item : cell->second) { function(item); }
+				}
+			}
+		}
+
+	public:
+		/// <param name="cellSize">Width and height of a cell in world space. Roughly the size of the areas usually queried
+		/// works best.</param>
+		SpatialHash(float cellSize);
+
+		/// <summary>
+		/// Add entities that have gained a position, move those whose position changed and remove those that have been
+		/// destroyed or lost their position. Call after <see cref="EntityManager::Update"/> so the views are current.
+		/// </summary>
+		void Update(EntityManager& entityManager);
+
+		/// <summary>
+		/// Rebuilds every cell, so avoid calling often.
+		/// </summary>
+		void SetCellSize(float cellSize);
+		float GetCellSize() const { return CellSize; }
+
+		void Clear();
+		size_t size() const { return TrackedCount; }
+
+		/// <returns>Every entity whose position is inside the area, edges included.</returns>
+		std::vector<Entity> QueryRectangle(Rectangle<float> area) const;
+
+		/// <returns>Every entity whose position is within the radius of the centre, edge included.</returns>
+		std::vector<Entity> QueryRadius(Vector2<float> centre, float radius) const;
+
+		/// <returns>Every entity in the same cell as the point, for when the caller does its own precise test, e.g.
+		/// against sprite bounds.</returns>
+		std::vector<Entity> QueryPoint(Vector2<float> point) const;
+	};
+}
@@ -11,7 +11,7 @@ Engine::CreateEntityCommand::CreateEntityCommand(ComponentSlice& components, std
 
 void Engine::CreateEntityCommand::Execute()
 {
-	CreatedEntity = OwningEntityManger.AddEntity("TileSet");
+	CreatedEntity = OwningEntityManger.AddEntity(Tags::TileSet);
 	auto initialiseEntity = [this]<typename... T>(T&... args) { (AddAndSetEnabledComponents<T>(*CreatedEntity), ...); };
 	std::apply(initialiseEntity, ComponentData);
 	SDL_Log("+Creating entity %d", CreatedEntity->GetID());
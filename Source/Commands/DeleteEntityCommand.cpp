@@ -20,8 +20,8 @@ void Engine::DeleteEntityCommand::Execute()
 
 void Engine::DeleteEntityCommand::Undo()
 {
-	CreatedEntity = OwningEntityManger.AddEntity("TileSet");
-	OwningEntityManger.SetPoolSlice(CreatedEntity->GetID(), ComponentData);
+	CreatedEntity = OwningEntityManger.AddEntity(Tags::TileSet);
 	OwningEntityManger.SetEnabledComponents(CreatedEntity->GetID(), EnabledComponents);
+	OwningEntityManger.SetPoolSlice(CreatedEntity->GetID(), ComponentData);
 	SDL_Log("+Creating entity %d", CreatedEntity->GetID());
 }
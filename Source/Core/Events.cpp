@@ -81,6 +81,9 @@ namespace Engine
 					WindowSize.Y = event.window.data2;
 				}
 				break;
+			case SDL_RENDER_TARGETS_RESET:
+				IsRenderTargetsReset = true;
+				break;
 			case SDL_KEYDOWN:
 			{
 				if (event.key.keysym.scancode == SDL_SCANCODE_1) // TODO: Remove. Temp VSYNC testing.
@@ -218,8 +221,14 @@ namespace Engine
 		return WindowSize;
 	}
 
+	bool Events::WereRenderTargetsReset() const
+	{
+		return IsRenderTargetsReset;
+	}
+
 	void Events::ResetStates()
 	{
 		MouseWheelY = 0;
+		IsRenderTargetsReset = false;
 	}
 }
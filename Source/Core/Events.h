@@ -35,6 +35,10 @@ namespace Engine
 		Vector2<int> GetMousePosition() const;
 		int GetMouseWheelY() const;
 		Vector2<int> GetWindowSize() const;
+
+		/// <returns>Whether the contents of textures drawn into were lost since the last frame, e.g. when a Direct3D
+		/// device is lost, so they need drawing again.</returns>
+		bool WereRenderTargetsReset() const;
 	private:
 		void ResetStates();
 
@@ -47,6 +51,7 @@ namespace Engine
 		Vector2<int> MousePosition;
 		char MouseButtonBitField = 0;
 		int MouseWheelY = 0;
+		bool IsRenderTargetsReset = false;
 		std::vector<SDL_GameController*> Controllers;
 		Vector2<int> WindowSize; // TODO: This should probably be on the window.
 	};
@@ -1,6 +1,7 @@
 #include "Game.h"
 #include "Settings.h"
 #include "Events.h"
+#include "Renderer.h"
 #include "../SceneManagement/BaseScene.h"
 #include "../SceneManagement/IGrid.h"
 #include "../SceneManagement/IsometricScene.h"
@@ -100,8 +101,9 @@ namespace Engine
 				ImGui::Text("Mouse Grid Position  : (%f, %f)", gridPosition.X, gridPosition.Y);
 
 			}
-			ImGui::Text("Camera Zoom          : (%f)", scene.MainCamera.GetComponent<Zoom>().Value);
+			ImGui::Text("Camera Zoom          : (%f)", scene.MainCamera.ReadComponent<Zoom>().Value);
 			ImGui::Text("Number of Entities   : (%zu)", EntityMemoryPool::Instance().GetEntityAliveCount()); // This will include entities alive in other loaded scenes.
+			ImGui::Text("Sprite Draw Calls    : (%zu)", Renderer::Instance().GetDrawCallCount()); // From the last frame.
 
 			ImGui::End();
 			settings.SetTargetFrameRate(maxFPS);
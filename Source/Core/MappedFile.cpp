@@ -0,0 +1,60 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Engine
+{
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::string& path)
+	{
+		FileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (FileHandle == INVALID_HANDLE_VALUE) { FileHandle = nullptr; return; }
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(FileHandle, &size) || size.QuadPart == 0) { return; }
+
+		MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!MappingHandle) { return; }
+
+		Data = static_cast<const std::byte*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (Data) { Size = static_cast<size_t>(size.QuadPart); }
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (Data) { UnmapViewOfFile(Data); }
+		if (MappingHandle) { CloseHandle(MappingHandle); }
+		if (FileHandle) { CloseHandle(FileHandle); }
+	}
+#else
+	MappedFile::MappedFile(const std::string& path)
+	{
+		FileDescriptor = open(path.c_str(), O_RDONLY);
+		if (FileDescriptor == -1) { return; }
+
+		struct stat status;
+		if (fstat(FileDescriptor, &status) == -1 || status.st_size == 0) { return; } // Empty files can't be mapped.
+
+		void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+		if (data == MAP_FAILED) { return; }
+
+		Data = static_cast<const std::byte*>(data);
+		Size = static_cast<size_t>(status.st_size);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (Data) { munmap(const_cast<std::byte*>(Data), Size); }
+		if (FileDescriptor != -1) { close(FileDescriptor); }
+	}
+#endif
+}
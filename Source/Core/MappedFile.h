@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Engine
+{
+	/// <summary>
+	/// A read only view of a whole file mapped into memory, so it can be read without copying it into a buffer first.
+	/// </summary>
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile& operator=(const MappedFile& other) = delete;
+
+		bool IsOpen() const { return Data != nullptr; }
+		const std::byte* GetData() const { return Data; }
+		size_t GetSize() const { return Size; }
+
+	private:
+		const std::byte* Data = nullptr;
+		size_t Size = 0;
+
+#ifdef _WIN32
+		void* FileHandle = nullptr;
+		void* MappingHandle = nullptr;
+#else
+		int FileDescriptor = -1;
+#endif
+	};
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Interns strings so that each is stored once and can be referred to by a compact ID, given out in order from 0.
+	/// </summary>
+	template<typename IdType>
+	class NameTable
+	{
+	private:
+		struct StringHash
+		{
+			using is_transparent = void; // Allows finding by string_view without constructing a string.
+			size_t operator()(std::string_view string) const { return std::hash<std::string_view>{}(string); }
+		};
+
+		std::vector<std::string> Names; // Indexed by ID.
+		std::unordered_map<std::string, IdType, StringHash, std::equal_to<>> IDs;
+
+	public:
+		/// <returns>The ID of the name, adding it if it hasn't been seen before. Only allocates for new names.</returns>
+		/// <exception cref="std::length_error">Thrown rather than wrapping round to reuse an ID when every one is taken.</exception>
+		IdType Intern(std::string_view name)
+		{
+			if (auto found = IDs.find(name); found != IDs.end()) { return found->second; }
+
+			if (Names.size() > std::numeric_limits<IdType>::max())
+			{
+				throw std::length_error("No IDs left to intern \"" + std::string(name) + "\".");
+			}
+
+			const IdType id = static_cast<IdType>(Names.size());
+			Names.emplace_back(name);
+			IDs.emplace(Names.back(), id);
+			return id;
+		}
+
+		const std::string& GetName(IdType id) const { return Names[id]; }
+
+		/// <summary>
+		/// The number of names interned so far, IDs are always less than this.
+		/// </summary>
+		size_t size() const { return Names.size(); }
+	};
+}
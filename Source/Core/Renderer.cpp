@@ -30,7 +30,7 @@ namespace Engine
 		SDL_Log("Renderer Initialisation!");
 
 		// SDL_RENDERER_ACCELERATED flag will enforce hardware acceleration, failing if unavailable. By default the SDL renderer will try to use hardware, but fall back to software if unavailable.
-		ManagedRenderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_PRESENTVSYNC);
+		ManagedRenderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE); // Static tiles are baked into target textures.
 		if (!ManagedRenderer)
 		{
 			SDL_Log("Error: %s\n", SDL_GetError());
@@ -111,7 +111,9 @@ namespace Engine
 			destination.x += destination.w;
 		}
 
-		Textures[fileName] = SDL_CreateTextureFromSurface(ManagedRenderer, atlas);
+		const TextureId id = TextureRegistry::Instance().GetId(fileName);
+		if (Textures.size() <= id) { Textures.resize(id + 1); }
+		Textures[id].emplace(SDL_CreateTextureFromSurface(ManagedRenderer, atlas));
 	}
 
 	void Renderer::SetVSync(bool value)
@@ -124,9 +126,11 @@ namespace Engine
 		// Prepare new frame.
 		SDL_SetRenderDrawColor(ManagedRenderer, 0, 0, 0, 255);
 		SDL_RenderClear(ManagedRenderer);
+		DrawCallCount = 0;
 
 		// Render world.
 		scene.Render(*this);
+		FlushSprites(); // In case the scene left any queued.
 		// RenderSprite(GetTexture("OpenSans.ttf"), { 0,0 }, (Vector2<float>)GetTexture("OpenSans.ttf").GetSize(), { 0, 0 }, GetTexture("OpenSans.ttf").GetSize());
 		// RenderText("OpenSans.ttf", "TEST!", { 0, 0 }, 1);
 
@@ -141,6 +145,82 @@ namespace Engine
 	{
 		// I feel clever for realising I can do this, but feel like I'm inviting disaster.
 		SDL_RenderCopyF(ManagedRenderer, texture, reinterpret_cast<SDL_Rect*>(&sourceRectangle), reinterpret_cast<SDL_FRect*>(&renderRectangle));
+		++DrawCallCount;
+	}
+
+	void Renderer::BatchSprite(Texture& texture, Rectangle<int> sourceRectangle, Rectangle<float> renderRectangle)
+	{
+		if (static_cast<SDL_Texture*>(texture) != BatchTexture)
+		{
+			FlushSprites();
+			BatchTexture = texture;
+			BatchTextureSize = static_cast<Vector2<float>>(texture.GetSize());
+		}
+
+		// Texture coordinates are normalised to the texture's size.
+		const float left = sourceRectangle.Position.X / BatchTextureSize.X;
+		const float top = sourceRectangle.Position.Y / BatchTextureSize.Y;
+		const float right = (sourceRectangle.Position.X + sourceRectangle.Size.X) / BatchTextureSize.X;
+		const float bottom = (sourceRectangle.Position.Y + sourceRectangle.Size.Y) / BatchTextureSize.Y;
+
+		const Vector2<float> topLeft = renderRectangle.Position;
+		const Vector2<float> bottomRight = renderRectangle.Position + renderRectangle.Size;
+		const SDL_Color colour = { 255, 255, 255, 255 };
+
+		// Two triangles per quad, sharing the corners along the diagonal.
+		const int first = static_cast<int>(BatchVertices.size());
+		BatchVertices.push_back({ { topLeft.X, topLeft.Y }, colour, { left, top } });
+		BatchVertices.push_back({ { bottomRight.X, topLeft.Y }, colour, { right, top } });
+		BatchVertices.push_back({ { topLeft.X, bottomRight.Y }, colour, { left, bottom } });
+		BatchVertices.push_back({ { bottomRight.X, bottomRight.Y }, colour, { right, bottom } });
+		BatchIndices.insert(BatchIndices.end(), { first, first + 1, first + 2, first + 1, first + 3, first + 2 });
+	}
+
+	void Renderer::FlushSprites()
+	{
+		if (!BatchVertices.empty())
+		{
+			SDL_RenderGeometry(ManagedRenderer, BatchTexture,
+				BatchVertices.data(), static_cast<int>(BatchVertices.size()),
+				BatchIndices.data(), static_cast<int>(BatchIndices.size()));
+			++DrawCallCount;
+		}
+
+		// Capacity is kept for the next batch.
+		BatchVertices.clear();
+		BatchIndices.clear();
+		BatchTexture = nullptr;
+	}
+
+	Texture Renderer::CreateRenderTarget(Vector2<int> size)
+	{
+		SDL_Texture* target = SDL_CreateTexture(ManagedRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.X, size.Y);
+		if (!target)
+		{
+			SDL_Log("Error: %s", SDL_GetError());
+			return Texture();
+		}
+
+		SDL_SetTextureBlendMode(target, SDL_BLENDMODE_BLEND); // Keep what isn't drawn into see-through.
+		return Texture(target);
+	}
+
+	void Renderer::BeginRenderTarget(Texture& target)
+	{
+		FlushSprites(); // Anything queued is meant for what was being drawn to before.
+		SDL_SetRenderTarget(ManagedRenderer, target);
+
+		Uint8 red, green, blue, alpha;
+		SDL_GetRenderDrawColor(ManagedRenderer, &red, &green, &blue, &alpha);
+		SDL_SetRenderDrawColor(ManagedRenderer, 0, 0, 0, 0);
+		SDL_RenderClear(ManagedRenderer);
+		SDL_SetRenderDrawColor(ManagedRenderer, red, green, blue, alpha);
+	}
+
+	void Renderer::EndRenderTarget()
+	{
+		FlushSprites();
+		SDL_SetRenderTarget(ManagedRenderer, nullptr);
 	}
 
 	void Renderer::RenderLine(Vector2<float> position1, Vector2<float> position2)
@@ -159,7 +239,7 @@ namespace Engine
 			Vector2<float> scaledSize = { source.w * scale, source.h * scale };
 
 			SDL_FRect destination = { renderPosition.X + positionOffset.X, renderPosition.Y + positionOffset.Y, scaledSize.X, scaledSize.Y };
-			SDL_RenderCopyF(ManagedRenderer, Textures[font], &source, &destination);
+			SDL_RenderCopyF(ManagedRenderer, GetTexture(font), &source, &destination);
 			positionOffset.X += scaledSize.X;
 		}
 	}
@@ -169,13 +249,12 @@ namespace Engine
 		SDL_SetRenderDrawColor(ManagedRenderer, red, green, blue, alpha);
 	}
 
-	Texture& Renderer::GetTexture(std::string fileName)
+	Texture& Renderer::GetTexture(TextureId id)
 	{
-		if (Textures.count(fileName) == 0) // Prevents unnecessary construction of existing texture.
-		{
-			Textures.try_emplace(fileName, Texture(ManagedRenderer, fileName));
-		}
+		if (Textures.size() <= id) { Textures.resize(id + 1); }
 
-		return Textures[fileName];
+		std::optional<Texture>& texture = Textures[id];
+		if (!texture) { texture.emplace(ManagedRenderer, TextureRegistry::Instance().GetName(id)); }
+		return *texture;
 	}
 }
\ No newline at end of file
@@ -2,11 +2,14 @@
 struct SDL_Window;
 struct SDL_Renderer;
 #include "Texture.h"
+#include "TextureRegistry.h"
 #include "../Maths/Vector2.h"
 #include "../Maths/Rectangle.h"
 #include <string>
 #include <array>
-#include <unordered_map>
+#include <deque>
+#include <optional>
+#include <vector>
 #include<SDL.h>
 
 namespace Engine
@@ -22,9 +25,18 @@ namespace Engine
 	private:
 		Renderer(SDL_Window* window);
 		~Renderer();
-		std::unordered_map<std::string, Texture> Textures; // std::unordered_map has faster look ups than std::map and order doesn't matter.
+		// Indexed by TextureId, a deque so that growing it doesn't move textures already handed out. Textures that failed
+		// to load are kept, so they aren't tried again every frame.
+		std::deque<std::optional<Texture>> Textures;
 		std::array<SDL_Rect, 128> Glyphs; // ASCII.
 
+		// Sprites queued by BatchSprite, all sharing one texture, drawn together by FlushSprites.
+		SDL_Texture* BatchTexture = nullptr;
+		Vector2<float> BatchTextureSize;
+		std::vector<SDL_Vertex> BatchVertices;
+		std::vector<int> BatchIndices;
+		size_t DrawCallCount = 0;
+
 		/// <summary>
 		/// Construct a font object,
 		/// </summary>
@@ -38,11 +50,38 @@ namespace Engine
 		void SetVSync(bool value);
 		void Render(BaseScene& scene);
 		void RenderSprite(Texture& texture, Rectangle<int> sourceRectangle, Rectangle<float> renderRectangle);
+
+		/// <summary>
+		/// Queue a sprite to be drawn along with the others using the same texture, in one call rather than one each.
+		/// Sprites are still drawn in the order they're queued, so a change of texture first draws those queued so far.
+		/// Keeping sprites that share a texture together, such as from an atlas, makes for the fewest calls.
+		/// </summary>
+		void BatchSprite(Texture& texture, Rectangle<int> sourceRectangle, Rectangle<float> renderRectangle);
+
+		/// <summary>
+		/// Draw every sprite queued by <see cref="BatchSprite"/>, which must be done before drawing anything else over them.
+		/// </summary>
+		void FlushSprites();
+
+		/// <returns>A transparent texture that can be drawn into, see <see cref="BeginRenderTarget"/>.</returns>
+		Texture CreateRenderTarget(Vector2<int> size);
+
+		/// <summary>
+		/// Draw into the texture rather than the window, clearing it first, until <see cref="EndRenderTarget"/>. The texture
+		/// must be from <see cref="CreateRenderTarget"/>.
+		/// </summary>
+		void BeginRenderTarget(Texture& target);
+		void EndRenderTarget();
+
+		/// <returns>How many draw calls sprites have taken so far this frame.</returns>
+		size_t GetDrawCallCount() const { return DrawCallCount; }
 		void RenderLine(Vector2<float> position1, Vector2<float> position2);
 		void RenderText(std::string font, std::string string, Vector2<float> renderPosition, float scale); // TODO: Make font an enum to prevent invalid enums.
 		void SetRenderColour(int red, int green, int blue, int alpha);
 
-		Texture& GetTexture(std::string fileName);
+		/// <returns>The texture for a handle, loading it from its file the first time.</returns>
+		Texture& GetTexture(TextureId id);
+		Texture& GetTexture(std::string_view fileName) { return GetTexture(TextureRegistry::Instance().GetId(fileName)); }
 
 		operator SDL_Renderer* () { return ManagedRenderer; } // Returns native renderer when passed into a SDL_Renderer * paramater.
 
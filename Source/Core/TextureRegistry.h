@@ -0,0 +1,48 @@
+#pragma once
+#include "NameTable.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Engine
+{
+	/// <summary>
+	/// A compact handle for a texture's file name, see <see cref="TextureRegistry"/>.
+	/// </summary>
+	using TextureId = uint16_t;
+
+	/// <summary>
+	/// The handle of the empty name, for sprites that haven't been given a texture.
+	/// </summary>
+	inline constexpr TextureId NoTexture = 0;
+
+	/// <summary>
+	/// Resolves texture file names to <see cref="TextureId"/>s, once when a sprite is loaded or edited, so that
+	/// sprites only hold a handle and the renderer can look textures up by index rather than hashing names each frame.
+	/// Handles only last for the session, so saves store the names instead.
+	/// </summary>
+	class TextureRegistry
+	{
+	private:
+		NameTable<TextureId> Names;
+
+		TextureRegistry() { GetId(""); }
+
+	public:
+		static TextureRegistry& Instance()
+		{
+			static TextureRegistry registry;
+			return registry;
+		}
+
+		/// <returns>The handle of the texture, adding it if it hasn't been seen before. Only allocates for new names.</returns>
+		TextureId GetId(std::string_view name) { return Names.Intern(name); }
+
+		const std::string& GetName(TextureId id) const { return Names.GetName(id); }
+
+		/// <summary>
+		/// The number of textures registered so far, handles are always less than this.
+		/// </summary>
+		size_t size() const { return Names.size(); }
+	};
+}
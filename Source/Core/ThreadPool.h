@@ -1,81 +1,406 @@
 #pragma once
-#include <thread>
-#include <mutex>
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <queue>
 
 namespace Engine
 {
-    // Courtesy of https://stackoverflow.com/a/32593825
-    class ThreadPool {
-    private:
-        bool should_terminate = false;           // Tells threads to stop looking for jobs
-        std::mutex queue_mutex;                  // Prevents data races to the job queue
-        std::condition_variable mutex_condition; // Allows threads to wait on new jobs or termination 
-        std::vector<std::thread> threads;
-        std::queue<std::function<void()>> jobs;
-
-    public:
-        void Start()
-    	{
-            const uint32_t num_threads = std::thread::hardware_concurrency(); // Max # of threads the system supports
-            for (uint32_t ii = 0; ii < num_threads; ++ii) {
-                threads.emplace_back(&ThreadPool::ThreadLoop, this);
-            }
-        }
-
-        void QueueJob(const std::function<void()>& job)
-    	{
-            {
-                std::unique_lock<std::mutex> lock(queue_mutex);
-                jobs.push(job);
-            }
-            mutex_condition.notify_one();
-        }
-
-        void Stop()
-    	{
-            {
-                std::unique_lock<std::mutex> lock(queue_mutex);
-                should_terminate = true;
-            }
-            mutex_condition.notify_all();
-            for (std::thread& active_thread : threads) {
-                active_thread.join();
-            }
-            threads.clear();
-        }
-
-        bool Busy()
-        {
-            bool poolbusy;
-            {
-                std::unique_lock<std::mutex> lock(queue_mutex);
-                poolbusy = !jobs.empty();
-            }
-            return poolbusy;
-        }
-
-    private:
-        void ThreadLoop()
-    	{
-            while (true) 
-            {
-                std::function<void()> job;
-                {
-                    std::unique_lock<std::mutex> lock(queue_mutex);
-                    mutex_condition.wait(lock, [this] {
-                        return !jobs.empty() || should_terminate;
-                    });
-                    if (should_terminate) {
-                        return;
-                    }
-                    job = jobs.front();
-                    jobs.pop();
-                }
-                job();
-            }
-        }
-    };
-}
\ No newline at end of file
+	/// <summary>
+	/// Counts unfinished jobs so that a batch of them can be waited on, see <see cref="ThreadPool::Wait"/>.
+	/// </summary>
+	struct TaskGroup
+	{
+		std::atomic<size_t> Remaining = 0;
+
+		bool IsDone() const { return Remaining.load(std::memory_order_acquire) == 0; }
+	};
+
+	/// <summary>
+	/// A type erased callable stored inline, so queuing a job never allocates.
+	/// </summary>
+	class Job
+	{
+	public:
+		static constexpr size_t BUFFER_SIZE = 64;
+
+	private:
+		alignas(std::max_align_t) std::byte Buffer[BUFFER_SIZE];
+		void (*Invoke)(void*) = nullptr;
+		void (*Relocate)(void* from, void* to) = nullptr; // Move constructs into to, then destroys from.
+		void (*Destroy)(void*) = nullptr;
+
+	public:
+		TaskGroup* Group = nullptr;
+
+		Job() = default;
+
+		template<typename F>
+			requires (!std::is_same_v<std::decay_t<F>, Job>)
+		Job(F&& function, TaskGroup* group = nullptr) : Group(group)
+		{
+			using Function = std::decay_t<F>;
+			static_assert(sizeof(Function) <= BUFFER_SIZE, "Job captures too much to be stored inline, capture a pointer instead.");
+			static_assert(alignof(Function) <= alignof(std::max_align_t), "Job is over aligned.");
+
+			new (Buffer) Function(std::forward<F>(function));
+			Invoke = [](void* function) { (*static_cast<Function*>(function))(); };
+			Relocate = [](void* from, void* to)
+			{
+				new (to) Function(std::move(*static_cast<Function*>(from)));
+				static_cast<Function*>(from)->~Function();
+			};
+			Destroy = [](void* function) { static_cast<Function*>(function)->~Function(); };
+		}
+
+		Job(Job&& other) noexcept { *this = std::move(other); }
+
+		Job& operator=(Job&& other) noexcept
+		{
+			if (this == &other) { return *this; }
+			Reset();
+			if (other.Invoke)
+			{
+				other.Relocate(other.Buffer, Buffer);
+				Invoke = std::exchange(other.Invoke, nullptr);
+				Relocate = std::exchange(other.Relocate, nullptr);
+				Destroy = std::exchange(other.Destroy, nullptr);
+			}
+			Group = std::exchange(other.Group, nullptr);
+			return *this;
+		}
+
+		Job(const Job&) = delete;
+		Job& operator=(const Job&) = delete;
+
+		~Job() { Reset(); }
+
+		void operator()() { Invoke(Buffer); }
+
+		void Reset()
+		{
+			if (!Invoke) { return; }
+			Destroy(Buffer);
+			Invoke = nullptr;
+		}
+	};
+
+	/// <summary>
+	/// A fixed capacity Chase-Lev deque. Only the owning thread pushes and pops the bottom, any thread can steal the top.
+	/// </summary>
+	/// <remarks>
+	/// Based on "Correct and Efficient Work-Stealing for Weak Memory Models", Lê et al. 2013. Jobs are stored in place
+	/// rather than as pointers, so each slot has a flag to stop the owner overwriting a job a thief is still moving out.
+	/// </remarks>
+	class WorkStealingDeque
+	{
+	public:
+		static constexpr int64_t CAPACITY = 1024; // Power of 2.
+
+	private:
+		struct Slot
+		{
+			Job Value;
+			std::atomic<bool> IsOccupied = false;
+		};
+
+		alignas(64) std::atomic<int64_t> Top = 0;
+		alignas(64) std::atomic<int64_t> Bottom = 0;
+		std::unique_ptr<Slot[]> Slots = std::make_unique<Slot[]>(CAPACITY);
+
+		Slot& GetSlot(int64_t index) { return Slots[index & (CAPACITY - 1)]; }
+
+		Job Take(Slot& slot)
+		{
+			Job job = std::move(slot.Value);
+			slot.IsOccupied.store(false, std::memory_order_release);
+			return job;
+		}
+
+	public:
+		/// <returns>False if full, in which case the job is left untouched.</returns>
+		bool Push(Job& job)
+		{
+			const int64_t bottom = Bottom.load(std::memory_order_relaxed);
+			const int64_t top = Top.load(std::memory_order_acquire);
+			Slot& slot = GetSlot(bottom);
+			if (bottom - top >= CAPACITY || slot.IsOccupied.load(std::memory_order_acquire)) { return false; }
+
+			slot.Value = std::move(job);
+			slot.IsOccupied.store(true, std::memory_order_relaxed);
+			Bottom.store(bottom + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// <summary>
+		/// Take the most recently pushed job. Owner only.
+		/// </summary>
+		std::optional<Job> Pop()
+		{
+			const int64_t bottom = Bottom.load(std::memory_order_relaxed) - 1;
+			Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = Top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Empty.
+				Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return std::nullopt;
+			}
+
+			if (top == bottom)
+			{
+				// Last job, race any thieves for it.
+				const bool isWon = Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				Bottom.store(bottom + 1, std::memory_order_relaxed);
+				if (!isWon) { return std::nullopt; }
+			}
+
+			return Take(GetSlot(bottom));
+		}
+
+		/// <summary>
+		/// Take the oldest job. Safe from any thread.
+		/// </summary>
+		std::optional<Job> Steal()
+		{
+			int64_t top = Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t bottom = Bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom) { return std::nullopt; }
+			if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) { return std::nullopt; }
+
+			return Take(GetSlot(top));
+		}
+	};
+
+	/// <summary>
+	/// A work stealing thread pool. Each worker has its own deque that it pushes to and pops from without locking, and
+	/// idle workers steal from the others. Jobs queued from outside of the pool go through a shared, locked queue.
+	/// </summary>
+	class ThreadPool
+	{
+	private:
+		struct Worker
+		{
+			WorkStealingDeque Jobs;
+			std::thread Thread;
+		};
+
+		std::vector<std::unique_ptr<Worker>> Workers;
+		std::deque<Job> SharedJobs; // For jobs queued by threads that aren't workers.
+		std::mutex SharedMutex; // Guards SharedJobs and sleeping.
+		std::condition_variable WakeCondition;
+
+		std::atomic<int64_t> QueuedCount = 0; // Queued but not yet started, so sleeping workers know there's work. Can briefly dip below 0.
+		std::atomic<size_t> SleepingCount = 0;
+		TaskGroup AllJobs; // Queued or running.
+		bool ShouldTerminate = false; // Guarded by SharedMutex.
+		std::atomic<bool> IsStopping = false;
+
+		inline static thread_local ThreadPool* CurrentPool = nullptr;
+		inline static thread_local size_t CurrentWorker = 0;
+
+		Worker* GetCurrentWorker() { return CurrentPool == this ? Workers[CurrentWorker].get() : nullptr; }
+
+		std::optional<Job> FindJob()
+		{
+			std::optional<Job> job;
+
+			// Newest local work first, it's most likely to still be in cache.
+			if (Worker* worker = GetCurrentWorker()) { job = worker->Jobs.Pop(); }
+
+			if (!job && QueuedCount.load() > 0)
+			{
+				std::unique_lock<std::mutex> lock(SharedMutex);
+				if (!SharedJobs.empty())
+				{
+					job = std::move(SharedJobs.front());
+					SharedJobs.pop_front();
+				}
+			}
+
+			// Steal starting from the next worker along so that thieves don't all hammer the same deque.
+			const size_t start = CurrentPool == this ? CurrentWorker + 1 : 0;
+			for (size_t i = 0; !job && i < Workers.size(); ++i)
+			{
+				job = Workers[(start + i) % Workers.size()]->Jobs.Steal();
+			}
+
+			if (job) { QueuedCount.fetch_sub(1); }
+			return job;
+		}
+
+		void Execute(Job& job)
+		{
+			TaskGroup* group = job.Group;
+			job();
+			job.Reset();
+
+			// Jobs queued by this job have already been counted, so reaching zero means everything is done.
+			if (group) { group->Remaining.fetch_sub(1, std::memory_order_acq_rel); }
+			AllJobs.Remaining.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		void WakeWorker()
+		{
+			if (SleepingCount.load() == 0) { return; }
+
+			// Sequentially consistent with the sleeping worker's counts, so either it sees the queued job or this sees it
+			// sleeping. Locking stops the notify landing between it checking for work and going to sleep.
+			std::unique_lock<std::mutex> lock(SharedMutex);
+			WakeCondition.notify_one();
+		}
+
+		void ThreadLoop(size_t index)
+		{
+			CurrentPool = this;
+			CurrentWorker = index;
+
+			while (!IsStopping.load(std::memory_order_relaxed))
+			{
+				if (std::optional<Job> job = FindJob())
+				{
+					Execute(*job);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(SharedMutex);
+				SleepingCount.fetch_add(1);
+				WakeCondition.wait(lock, [this] { return QueuedCount.load() > 0 || ShouldTerminate; });
+				SleepingCount.fetch_sub(1);
+				if (ShouldTerminate) { return; }
+			}
+		}
+
+	public:
+		~ThreadPool() { Stop(); }
+
+		void Start()
+		{
+			// hardware_concurrency can report 0 if it isn't known.
+			const size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+			IsStopping = false;
+			ShouldTerminate = false;
+			Workers.clear();
+			for (size_t i = 0; i < threadCount; ++i) { Workers.emplace_back(std::make_unique<Worker>()); }
+
+			// Only start threads once every deque exists, as they steal from each other straight away.
+			for (size_t i = 0; i < threadCount; ++i) { Workers[i]->Thread = std::thread(&ThreadPool::ThreadLoop, this, i); }
+		}
+
+		/// <summary>
+		/// Stops every worker once their current job is done. Jobs still queued are dropped.
+		/// </summary>
+		void Stop()
+		{
+			if (Workers.empty()) { return; }
+
+			{
+				std::unique_lock<std::mutex> lock(SharedMutex);
+				ShouldTerminate = true;
+			}
+			IsStopping = true;
+			WakeCondition.notify_all();
+
+			for (std::unique_ptr<Worker>& worker : Workers) { worker->Thread.join(); }
+			Workers.clear();
+			SharedJobs.clear();
+			QueuedCount = 0;
+			AllJobs.Remaining = 0;
+		}
+
+		/// <summary>
+		/// Queue a job, optionally counting it in a group so it can be waited on with <see cref="Wait"/>.
+		/// Jobs queued from a worker go on that worker's own deque without locking.
+		/// </summary>
+		/// <remarks>
+		/// Captures must fit in <see cref="Job::BUFFER_SIZE"/> bytes.
+		/// </remarks>
+		template<typename F>
+		void QueueJob(F&& function, TaskGroup* group = nullptr)
+		{
+			Job job(std::forward<F>(function), group);
+
+			// Counted before it can possibly run, so a wait can't see zero while a job is still to come.
+			if (group) { group->Remaining.fetch_add(1, std::memory_order_acq_rel); }
+			AllJobs.Remaining.fetch_add(1, std::memory_order_acq_rel);
+
+			Worker* worker = GetCurrentWorker();
+			if (worker && !worker->Jobs.Push(job))
+			{
+				// The deque is full, run it now rather than wait on room.
+				Execute(job);
+				return;
+			}
+			if (!worker)
+			{
+				std::unique_lock<std::mutex> lock(SharedMutex);
+				SharedJobs.emplace_back(std::move(job));
+			}
+
+			QueuedCount.fetch_add(1);
+			WakeWorker();
+		}
+
+		bool Busy() const { return !AllJobs.IsDone(); }
+
+		/// <summary>
+		/// Blocks until every job in the group has finished, running queued jobs on this thread in the meantime.
+		/// Safe to call from within a job.
+		/// </summary>
+		void Wait(const TaskGroup& group)
+		{
+			while (!group.IsDone())
+			{
+				if (std::optional<Job> job = FindJob()) { Execute(*job); }
+				else { std::this_thread::yield(); }
+			}
+		}
+
+		/// <summary>
+		/// Blocks until every queued job has finished, including any jobs queued by those jobs.
+		/// </summary>
+		/// <remarks>
+		/// Don't call this from within a job, it would wait on itself. Use a <see cref="TaskGroup"/> instead.
+		/// </remarks>
+		void WaitForAll() { Wait(AllJobs); }
+
+		/// <summary>
+		/// Calls function(begin, end) over [begin, end) split into ranges of at most grain, in parallel, blocking until
+		/// every range is done. The calling thread helps out.
+		/// </summary>
+		template<typename F>
+		void ParallelFor(size_t begin, size_t end, size_t grain, const F& function)
+		{
+			if (begin >= end) { return; }
+			grain = std::max<size_t>(grain, 1);
+
+			// The last range is run on this thread rather than queued, as it's about to wait anyway.
+			TaskGroup group;
+			size_t rangeBegin = begin;
+			for (; end - rangeBegin > grain; rangeBegin += grain)
+			{
+				QueueJob([&function, rangeBegin, grain]() { function(rangeBegin, rangeBegin + grain); }, &group);
+			}
+			function(rangeBegin, end);
+
+			Wait(group);
+		}
+
+		size_t GetThreadCount() const { return Workers.size(); }
+	};
+}
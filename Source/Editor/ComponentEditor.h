@@ -1,6 +1,7 @@
 #pragma once
 #include "../EntityComponentSystem/Components.h"
 #include "../EntityComponentSystem/EntityMemoryPool.h"
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include "../Maths/Vector2.h"
@@ -27,6 +28,17 @@ namespace Engine
 
 	// TODO: Need to change all instances of std::get<T> to be std::get<T&>.
 
+	template<>
+	inline void ComponentEditor<TerrainCost>(ComponentReferenceSlice& components, const std::bitset<MAX_COMPONENTS>& EnabledComponents)
+	{
+		const bool isEnabled = EnabledComponents[tuple_element_index_v<TerrainCost, ComponentSlice>];
+		if (!isEnabled) { return; }
+
+		int& cost = std::get<TerrainCost&>(components).Cost;
+		ImGui::InputInt("Terrain Cost", &cost);
+		cost = std::clamp(cost, 1, 255);
+	}
+
 	template<>
 	inline void ComponentEditor<Collider>(ComponentReferenceSlice& components, const std::bitset<MAX_COMPONENTS>& EnabledComponents)
 	{
@@ -37,7 +49,7 @@ namespace Engine
 		if (isMissingDependencies) { ImGui::Text("COLLIDER COMPONENT REQUIRES SPRITE COMPONENT!"); return; } // TODO: Report missing sprite component in whatever system deals with colliders?
 
 		const Sprite& sprite = std::get<Sprite&>(components);
-		if (sprite.TextureName[0] == '\0') { ImGui::Text("MISSING TEXTURE!"); return; }
+		if (sprite.Texture == NoTexture) { ImGui::Text("MISSING TEXTURE!"); return; }
 
 		// TODO: Pass in an EditorEntity, which manages either a component slice or an actual corresponding entity so that IsEnabled checks can be done.
 		// This may as well be set for all calls. TODO: This may run into problems with the clamping if two different editors are opened with different tile sizes.
@@ -56,7 +68,7 @@ namespace Engine
 		Snapping = Vector2<int>::Clamp(Snapping, { 1, 1 }, sprite.SourceRectangle.Size / 4); // TODO: Lock values to each other with optional button to disable.
 
 		// Collision Input.
-		Texture& sourceTexture = Renderer::Instance().GetTexture(sprite.TextureName);
+		Texture& sourceTexture = Renderer::Instance().GetTexture(sprite.Texture);
 		const Vector2<float> atlasSize = (Vector2<float>)sourceTexture.GetSize();
 		const Vector2<float> uvTopLeft = { (float)sprite.SourceRectangle.Position.X / atlasSize.X, (float)sprite.SourceRectangle.Position.Y / atlasSize.Y };
 		const Vector2<float> uvBottomRight = { ((float)sprite.SourceRectangle.Position.X + tileSize.X) / atlasSize.X, ((float)sprite.SourceRectangle.Position.Y + tileSize.Y) / atlasSize.Y };
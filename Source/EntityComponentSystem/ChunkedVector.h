@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace Engine
+{
+	/// <summary>
+	/// A vector that grows by allocating fixed size chunks, so growing never relocates existing elements and references
+	/// to them stay valid.
+	/// </summary>
+	/// <remarks>
+	/// Growing isn't thread safe, it should only be done when nothing else is accessing the vector.
+	/// </remarks>
+	template<typename T, size_t ChunkSize = 4096>
+	class ChunkedVector
+	{
+		std::vector<std::unique_ptr<T[]>> Chunks;
+		size_t Size = 0;
+
+	public:
+		static constexpr size_t CHUNK_SIZE = ChunkSize;
+
+		/// <summary>
+		/// Grow to hold at least the given number of elements. New elements are value initialised. Never shrinks.
+		/// </summary>
+		void Resize(size_t size)
+		{
+			while (Chunks.size() * ChunkSize < size)
+			{
+				Chunks.emplace_back(std::make_unique<T[]>(ChunkSize));
+			}
+			Size = std::max(Size, size);
+		}
+
+		void PushBack(T value)
+		{
+			Resize(Size + 1);
+			(*this)[Size - 1] = std::move(value);
+		}
+
+		/// <summary>
+		/// Removes the last element, resetting it to default. The memory is kept for reuse.
+		/// </summary>
+		void PopBack()
+		{
+			(*this)[Size - 1] = {};
+			--Size;
+		}
+
+		T& Back() { return (*this)[Size - 1]; }
+
+		T& operator[](size_t index) { return Chunks[index / ChunkSize][index % ChunkSize]; }
+		const T& operator[](size_t index) const { return Chunks[index / ChunkSize][index % ChunkSize]; }
+
+		size_t size() const { return Size; }
+		size_t capacity() const { return Chunks.size() * ChunkSize; }
+	};
+}
@@ -1,5 +1,8 @@
 #pragma once
+#include "ComponentStorage.h"
+#include <bitset>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace Engine
@@ -12,24 +15,61 @@ namespace Engine
 
 	template<template<typename...Args> class t, typename ...Ts>
 	struct ComponentHelper<t<Ts...>> {
-		using Pool = std::tuple<std::vector<Ts>...>;
+		using Pool = std::tuple<ComponentStorage<Ts>...>;
 		using Slice = std::tuple<Ts...>;
 		using ReferenceSlice = std::tuple<Ts&...>;
 
+		static constexpr size_t Count = sizeof...(Ts);
+
+		/// <summary>
+		/// Calls function.template operator()&lt;T, Index&gt;() for each component type, in order.
+		/// </summary>
+		template<typename F>
+		static void ForEachType(F&& function)
+		{
+			[&function]<size_t... Index>(std::index_sequence<Index...>)
+			{
+				(function.template operator()<Ts, Index>(), ...);
+			}(std::index_sequence_for<Ts...>{});
+		}
+
 		// Sometimes it's necessary to capture a copy of an entity, or to set up an entity later, and so to avoid virtual overhead the functions are necessary.
 		static ReferenceSlice CreateReferenceSlice(Slice& slice)
 		{
 			return std::tie(std::get<Ts>(slice) ...);
 		}
 
-		static ReferenceSlice CreateReferenceSlice(Pool& pool, size_t id)
+		/// <summary>
+		/// Reference every component of an entity in the pool. Sparsely stored components that aren't enabled refer to
+		/// the scratch slice's instead, reset to default, so that they aren't stored.
+		/// </summary>
+		template<size_t N>
+		static ReferenceSlice CreateReferenceSlice(Pool& pool, size_t id, const std::bitset<N>& enabled, Slice& scratch)
+		{
+			return [&]<size_t... Index>(std::index_sequence<Index...>)
+			{
+				return ReferenceSlice(GetReference<Ts, Index>(pool, id, enabled, scratch)...);
+			}(std::index_sequence_for<Ts...>{});
+		}
+
+		template<typename T, size_t Index, size_t N>
+		static T& GetReference(Pool& pool, size_t id, const std::bitset<N>& enabled, Slice& scratch)
 		{
-			return std::tie( std::get<std::vector<Ts>>(pool)[id] ... );
+			if constexpr (IsSparse<T>)
+			{
+				if (!enabled[Index])
+				{
+					T& value = std::get<T>(scratch);
+					value = {};
+					return value;
+				}
+			}
+			return std::get<ComponentStorage<T>>(pool)[id];
 		}
 
 		static Slice CreateSlice(Pool& pool, size_t id)
 		{
-			return std::make_tuple(std::get<std::vector<Ts>>(pool)[id] ...);
+			return std::make_tuple(std::get<ComponentStorage<Ts>>(pool).Copy(id) ...);
 		}
 	};
 
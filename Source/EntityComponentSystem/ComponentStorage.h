@@ -0,0 +1,186 @@
+#pragma once
+#include "ChunkedVector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Engine
+{
+	/// <summary>
+	/// Stores a component for every entity, indexed directly by entity ID. Best for components that most entities have.
+	/// </summary>
+	template<typename T>
+	class DenseStorage
+	{
+		ChunkedVector<T> Components; // Chunked so that growing the pool doesn't move components out from under references.
+		ChunkedVector<uint32_t> ChangedTicks; // The tick each component was last changed on.
+
+	public:
+		void Resize(size_t size)
+		{
+			Components.Resize(size);
+			ChangedTicks.Resize(size);
+		}
+
+		T& operator[](size_t id) { return Components[id]; }
+		const T& operator[](size_t id) const { return Components[id]; }
+		const T& Get(size_t id) const { return Components[id]; }
+		T Copy(size_t id) const { return Components[id]; }
+
+		void MarkChanged(size_t id, uint32_t tick) { ChangedTicks[id] = tick; }
+		uint32_t GetChangedTick(size_t id) const { return ChangedTicks[id]; }
+
+		/// <summary>
+		/// Reset to default ready for an entity ID to be reused.
+		/// </summary>
+		void Reset(size_t id)
+		{
+			Components[id] = {};
+			ChangedTicks[id] = 0;
+		}
+
+		/// <summary>
+		/// Copy components stored as raw bytes into consecutive IDs starting at the given one, marking them changed. Each
+		/// chunk's components are contiguous, so this is a copy per chunk rather than per component.
+		/// </summary>
+		void CopyFrom(size_t id, const void* source, size_t count, uint32_t tick)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Components are copied as raw bytes.");
+
+			const std::byte* bytes = static_cast<const std::byte*>(source);
+			while (count > 0)
+			{
+				const size_t copyCount = std::min(count, decltype(Components)::CHUNK_SIZE - id % decltype(Components)::CHUNK_SIZE);
+				std::memcpy(&Components[id], bytes, sizeof(T) * copyCount);
+				std::fill_n(&ChangedTicks[id], copyCount, tick);
+				bytes += sizeof(T) * copyCount;
+				id += copyCount;
+				count -= copyCount;
+			}
+		}
+
+		/// <summary>
+		/// Memory is always in use, so there's nothing to free.
+		/// </summary>
+		void Remove(size_t /*id*/) {}
+	};
+
+	/// <summary>
+	/// A sparse set that only stores components for the entities that have them, packed together so iterating them is
+	/// a linear scan. Best for rare or heavy components, at the cost of an extra indirection per access.
+	/// </summary>
+	/// <remarks>
+	/// Removing a component moves the last component into its place, so references are only stable until a removal.
+	/// Adding a component never moves the others.
+	/// </remarks>
+	template<typename T>
+	class SparseStorage
+	{
+		static constexpr uint32_t NotStored = std::numeric_limits<uint32_t>::max();
+		static constexpr size_t ChunkSize = 128; // Small, as few entities have these and the first one allocates a chunk.
+
+		ChunkedVector<T, ChunkSize> Components; // Dense.
+		ChunkedVector<uint32_t, ChunkSize> ChangedTicks; // Dense, the tick each component was last changed on.
+		std::vector<size_t> Entities; // Dense, the entity ID each component belongs to.
+		std::vector<uint32_t> Indices; // Sparse, entity ID to its index in Components.
+
+	public:
+		void Resize(size_t size) { Indices.resize(size, NotStored); }
+
+		/// <summary>
+		/// Get the component for writing, storing a default one if the entity doesn't already have one. Use
+		/// <see cref="Get"/> to only read.
+		/// </summary>
+		T& operator[](size_t id)
+		{
+			if (Indices[id] == NotStored)
+			{
+				Indices[id] = static_cast<uint32_t>(Components.size());
+				Components.PushBack({});
+				ChangedTicks.PushBack(0);
+				Entities.push_back(id);
+			}
+
+			return Components[Indices[id]];
+		}
+
+		/// <returns>The component, or a shared default without storing one if the entity doesn't have one.</returns>
+		const T& Get(size_t id) const
+		{
+			static const T defaultComponent{};
+			return Indices[id] == NotStored ? defaultComponent : Components[Indices[id]];
+		}
+
+		/// <returns>A copy of the component, or a default component without storing one if the entity doesn't have one.</returns>
+		T Copy(size_t id) const
+		{
+			if (Indices[id] == NotStored) { return {}; }
+			return Components[Indices[id]];
+		}
+
+		bool Contains(size_t id) const { return Indices[id] != NotStored; }
+
+		/// <summary>
+		/// Does nothing if the entity doesn't have a component stored.
+		/// </summary>
+		void MarkChanged(size_t id, uint32_t tick)
+		{
+			if (Indices[id] != NotStored) { ChangedTicks[Indices[id]] = tick; }
+		}
+
+		/// <returns>The tick the component was last changed on, or 0 if the entity doesn't have one stored.</returns>
+		uint32_t GetChangedTick(size_t id) const
+		{
+			return Indices[id] == NotStored ? 0 : ChangedTicks[Indices[id]];
+		}
+
+		void Reset(size_t id) { Remove(id); }
+
+		void Remove(size_t id)
+		{
+			if (Indices[id] == NotStored) { return; }
+
+			// Swap and pop to keep the components packed.
+			const uint32_t index = Indices[id];
+			const size_t last = Entities.back();
+			Components[index] = std::move(Components.Back());
+			ChangedTicks[index] = ChangedTicks.Back();
+			Entities[index] = last;
+			Indices[last] = index;
+
+			Components.PopBack();
+			ChangedTicks.PopBack();
+			Entities.pop_back();
+			Indices[id] = NotStored;
+		}
+
+		size_t size() const { return Components.size(); }
+
+		/// <summary>
+		/// Access by packed index rather than entity ID, for a linear scan over every stored component.
+		/// </summary>
+		T& GetPacked(size_t index) { return Components[index]; }
+
+		/// <returns>The entity ID of each stored component, in the same order as <see cref="GetPacked"/>.</returns>
+		const std::vector<size_t>& GetEntities() const { return Entities; }
+	};
+
+	/// <summary>
+	/// Chooses how a component is stored, dense by default. Specialise for a component to change its storage.
+	/// </summary>
+	template<typename T>
+	struct StoragePolicy
+	{
+		using Type = DenseStorage<T>;
+	};
+
+	template<typename T>
+	using ComponentStorage = typename StoragePolicy<T>::Type;
+
+	template<typename T>
+	inline constexpr bool IsSparse = std::is_same_v<ComponentStorage<T>, SparseStorage<T>>;
+}
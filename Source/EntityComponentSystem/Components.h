@@ -2,8 +2,10 @@
 #include "ComponentHelper.h"
 #include "../Maths/Vector2.h"
 #include "../Maths/Rectangle.h"
+#include "../Core/TextureRegistry.h"
 #include <optional>
 #include <array>
+#include <string_view>
 
 // TODO: Constructors that are forwarded to AddComponent() in the EntityMemoryPool so that I don't need to manually do
 // setup.
@@ -37,7 +39,10 @@ namespace Engine
 	/// </summary>
 	struct Sprite
 	{
-		char TextureName[64] = "\0";
+		/// <summary>
+		/// Resolved from the texture's file name by the <see cref="TextureRegistry"/>.
+		/// </summary>
+		TextureId Texture = NoTexture;
 
 		/// <summary>
 		/// Sub-rectangle of texture to render.
@@ -79,8 +84,32 @@ namespace Engine
 		Vector2<float> Goal;
 	};
 
-	using Components = TypeList<Position, Velocity, Zoom, Sprite, Animation, Collider, Pathfinding>;
+	/// <summary>
+	/// Makes the grid cell an entity is on slower to path through, such as mud or shallow water.
+	/// </summary>
+	struct TerrainCost
+	{
+		/// <summary>
+		/// Cost of moving into the cell, where 1 is normal ground. Clamped to 1 to 255 when baked.
+		/// </summary>
+		int Cost = 1;
+	};
+
+	// Colliders, pathfinding and terrain costs are rare compared to tiles, and colliders are heavy, so only store them for the entities that have them.
+	template<> struct StoragePolicy<Collider> { using Type = SparseStorage<Collider>; };
+	template<> struct StoragePolicy<Pathfinding> { using Type = SparseStorage<Pathfinding>; };
+	template<> struct StoragePolicy<TerrainCost> { using Type = SparseStorage<TerrainCost>; };
+
+	using Components = TypeList<Position, Velocity, Zoom, Sprite, Animation, Collider, Pathfinding, TerrainCost>;
 	using ComponentPool = ComponentHelper<Components>::Pool;
 	using ComponentSlice = ComponentHelper<Components>::Slice;
 	using ComponentReferenceSlice = ComponentHelper<Components>::ReferenceSlice;
+
+	/// <summary>
+	/// Used to match components in save files, so don't rename them. Same order as <see cref="Components"/>.
+	/// </summary>
+	inline constexpr std::array<std::string_view, ComponentHelper<Components>::Count> ComponentNames =
+	{
+		"Position", "Velocity", "Zoom", "Sprite", "Animation", "Collider", "Pathfinding", "TerrainCost"
+	};
 }
\ No newline at end of file
@@ -5,17 +5,27 @@ namespace Engine
 {
 	/// <summary>
 	/// Entity is essentially just a wrapper around an integer ID that has helper functions to get components.
+	/// The ID's generation is stored alongside it, so that a handle kept after its entity is destroyed can be detected
+	/// even if the ID has been reused.
 	/// </summary>
 	class Entity
 	{
 		size_t ID;
-		Entity(size_t id) : ID(id) {}
+		uint32_t Generation;
+		Entity(size_t id) : ID(id), Generation(EntityMemoryPool::Instance().GetGeneration(id)) {}
 		friend class EntityManager;
+		friend class EntityView;
+		friend class ChangedEntityView;
 
 	public:
-		size_t GetID() { return ID; }
+		size_t GetID() const { return ID; }
+		uint32_t GetGeneration() const { return Generation; }
 
-		std::string GetTag() { return EntityMemoryPool::Instance().GetTag(ID); }
+		/// <returns>False if the entity has been destroyed, even if its ID has since been reused.</returns>
+		bool IsAlive() const { return EntityMemoryPool::Instance().IsValid(ID, Generation); }
+
+		TagId GetTag() const { return EntityMemoryPool::Instance().GetTag(ID); }
+		const std::string& GetTagName() const { return TagTable::Instance().GetName(GetTag()); }
 
 		template<typename T>
 		T& AddComponent()
@@ -24,6 +34,15 @@ namespace Engine
 			return EntityMemoryPool::Instance().GetComponent<T>(ID);
 		}
 
+		template<typename T>
+		void RemoveComponent()
+		{
+			EntityMemoryPool::Instance().RemoveComponent<T>(ID);
+		}
+
+		/// <remarks>
+		/// Marks the component as changed, use <see cref="ReadComponent"/> when only reading.
+		/// </remarks>
 		template<typename T>
 		T& GetComponent()
 		{
@@ -33,7 +52,32 @@ namespace Engine
 		template<typename T>
 		const T& GetComponent() const
 		{
-			return EntityMemoryPool::Instance().GetComponent<T>(ID);
+			return ReadComponent<T>();
+		}
+
+		/// <summary>
+		/// Get a component without marking it as changed.
+		/// </summary>
+		template<typename T>
+		const T& ReadComponent() const
+		{
+			return EntityMemoryPool::Instance().ReadComponent<T>(ID);
+		}
+
+		/// <summary>
+		/// Mark a component as changed this tick, for when it's been changed through a reference kept from earlier.
+		/// </summary>
+		template<typename T>
+		void MarkChanged()
+		{
+			EntityMemoryPool::Instance().MarkChanged<T>(ID);
+		}
+
+		/// <returns>The tick the component was last changed on, 0 if it never has been.</returns>
+		template<typename T>
+		uint32_t GetChangedTick() const
+		{
+			return EntityMemoryPool::Instance().GetChangedTick<T>(ID);
 		}
 
 		template<typename T>
@@ -48,7 +92,7 @@ namespace Engine
 			return EntityMemoryPool::Instance().HasComponents<T...>(ID);
 		}
 
-		bool operator== (const Entity& right) const { return ID == right.ID; };
+		bool operator== (const Entity& right) const { return ID == right.ID && Generation == right.Generation; };
 
 	};
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+#include "Entity.h"
+#include "EntityManager.h"
+#include "Tag.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Records structural changes (creating and destroying entities, adding and removing components) so they can be made
+	/// later on one thread, as they aren't safe to make while systems are running in parallel.
+	/// </summary>
+	/// <remarks>
+	/// Systems run by <see cref="SystemScheduler"/> get a buffer per chunk through <see cref="GetCurrent"/>, which are
+	/// played back in system then chunk order so the result doesn't depend on which thread ran what.
+	/// </remarks>
+	class EntityCommandBuffer
+	{
+	public:
+		/// <summary>
+		/// An entity that will be created on playback. Only valid with the buffer that created it.
+		/// </summary>
+		struct PendingEntity
+		{
+			uint32_t Index;
+		};
+
+	private:
+		using Target = std::variant<Entity, PendingEntity>;
+
+		struct Command
+		{
+			enum class Type : uint8_t { Create, Destroy, Apply };
+
+			Type Kind;
+			Target Subject;
+			TagId Tag = 0;
+			size_t DataOffset = 0;
+			void (*Apply)(Entity, const std::byte*) = nullptr; // Adds or removes a component.
+		};
+
+		std::vector<Command> Commands;
+		std::vector<std::byte> Data; // Component values to add, copied in as raw bytes.
+		uint32_t CreatedCount = 0;
+
+		inline static thread_local EntityCommandBuffer* Current = nullptr;
+
+		template<typename T>
+		void RecordAddComponent(Target entity, const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Components are recorded as raw bytes.");
+
+			const size_t offset = Data.size();
+			Data.resize(offset + sizeof(T));
+			std::memcpy(Data.data() + offset, &value, sizeof(T));
+
+			Commands.push_back({ Command::Type::Apply, entity, 0, offset, [](Entity entity, const std::byte* data)
+			{
+				std::memcpy(&entity.AddComponent<T>(), data, sizeof(T));
+			} });
+		}
+
+	public:
+		PendingEntity Create(TagId tag)
+		{
+			const PendingEntity entity{ CreatedCount++ };
+			Commands.push_back({ Command::Type::Create, entity, tag });
+			return entity;
+		}
+
+		PendingEntity Create(std::string_view tag) { return Create(TagTable::Instance().Intern(tag)); }
+
+		void Destroy(Entity entity) { Commands.push_back({ Command::Type::Destroy, entity }); }
+
+		template<typename T>
+		void AddComponent(Entity entity, const T& value = {}) { RecordAddComponent<T>(entity, value); }
+
+		template<typename T>
+		void AddComponent(PendingEntity entity, const T& value = {}) { RecordAddComponent<T>(entity, value); }
+
+		template<typename T>
+		void RemoveComponent(Entity entity)
+		{
+			Commands.push_back({ Command::Type::Apply, entity, 0, 0, [](Entity entity, const std::byte*)
+			{
+				entity.RemoveComponent<T>();
+			} });
+		}
+
+		bool empty() const { return Commands.empty(); }
+
+		/// <summary>
+		/// Make every recorded change, in the order they were recorded, then clear the buffer. Changes to entities that
+		/// have since been destroyed are skipped.
+		/// </summary>
+		void Playback(EntityManager& entityManager)
+		{
+			std::vector<Entity> created;
+			created.reserve(CreatedCount);
+
+			for (const Command& command : Commands)
+			{
+				if (command.Kind == Command::Type::Create)
+				{
+					created.push_back(entityManager.AddEntity(command.Tag));
+					continue;
+				}
+
+				const Entity entity = std::holds_alternative<Entity>(command.Subject) ?
+					std::get<Entity>(command.Subject) :
+					created[std::get<PendingEntity>(command.Subject).Index];
+				if (!entity.IsAlive()) { continue; }
+
+				if (command.Kind == Command::Type::Destroy) { entityManager.Destroy(entity); }
+				else { command.Apply(entity, Data.data() + command.DataOffset); }
+			}
+
+			Clear();
+		}
+
+		void Clear()
+		{
+			Commands.clear();
+			Data.clear();
+			CreatedCount = 0;
+		}
+
+		/// <returns>The buffer for the system chunk running on this thread.</returns>
+		/// <remarks>
+		/// Only valid from within a system run by <see cref="SystemScheduler"/>.
+		/// </remarks>
+		static EntityCommandBuffer& GetCurrent() { return *Current; }
+
+		/// <summary>
+		/// Sets the current buffer for this thread until it goes out of scope.
+		/// </summary>
+		class Scope
+		{
+			EntityCommandBuffer* Previous;
+
+		public:
+			Scope(EntityCommandBuffer& buffer) : Previous(std::exchange(Current, &buffer)) {}
+			~Scope() { Current = Previous; }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		};
+	};
+}
@@ -1,21 +1,24 @@
 #pragma once
 #include "Entity.h"
 #include "EntityMemoryPool.h"
+#include "EntityView.h"
+#include "SceneFormat.h"
+#include "../Core/MappedFile.h"
 #include <vector>
-#include <map>
+#include <deque>
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <fstream>
-#include <sstream>
 #include <cstring>
+#include <limits>
+#include <optional>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
 
 namespace Engine
 {
-	struct SerialisedData
-	{
-		std::bitset<MAX_COMPONENTS> EnabledComponents;
-		char Tag[64];
-		ComponentSlice Slice;
-	};
-
 	class EntityManager
 	{
 		std::vector<Entity> Entities;
@@ -23,68 +26,355 @@ namespace Engine
 		/// Because of vector resizing there is the potential for iterator invalidation if directly altering <see cref="Entities"/>.
 		/// </summary>
 		std::vector<Entity>	EntitiesToAdd;
-		std::map<std::string, std::vector<Entity>> EntitiesByTag;
+		std::vector<Entity> EntitiesToDestroy; // Removed from the lists on Update, so destroying while iterating them is safe.
+		std::deque<std::vector<Entity>> EntitiesByTag; // Indexed by TagId. Deque so that references survive new tags.
+
+		/// <summary>
+		/// Where an entity is in the lists, so it can be swapped and popped out of them rather than searched for.
+		/// </summary>
+		struct EntityLocation
+		{
+			static constexpr size_t NotStored = std::numeric_limits<size_t>::max();
+
+			size_t Index = NotStored; // In EntitiesToAdd if IsPending, otherwise Entities.
+			size_t TagIndex = NotStored;
+			TagId Tag = 0; // Kept here as the memory pool's copy is overwritten if the ID is reused.
+			bool IsPending = false;
+		};
+		std::vector<EntityLocation> Locations; // Indexed by entity ID, each ID is in the lists at most once.
+
+		/// <summary>
+		/// Remove the entity currently using the ID from every list.
+		/// </summary>
+		void RemoveFromLists(size_t id)
+		{
+			EntityLocation& location = Locations[id];
+
+			std::vector<Entity>& entities = location.IsPending ? EntitiesToAdd : Entities;
+			const Entity lastEntity = entities.back();
+			entities[location.Index] = lastEntity;
+			Locations[lastEntity.ID].Index = location.Index;
+			entities.pop_back();
+
+			std::vector<Entity>& sameTagEntities = GetEntitiesByTag(location.Tag);
+			const Entity lastTagged = sameTagEntities.back();
+			sameTagEntities[location.TagIndex] = lastTagged;
+			Locations[lastTagged.ID].TagIndex = location.TagIndex;
+			sameTagEntities.pop_back();
+
+			location = {};
+		}
+
+		/// <returns>Whether the entity (not just its ID) is still in the lists.</returns>
+		bool IsInLists(Entity entity) const
+		{
+			if (entity.ID >= Locations.size()) { return false; }
+
+			const EntityLocation& location = Locations[entity.ID];
+			if (location.Index == EntityLocation::NotStored) { return false; }
+
+			const std::vector<Entity>& entities = location.IsPending ? EntitiesToAdd : Entities;
+			return entities[location.Index] == entity;
+		}
 
 	public:
 		~EntityManager()
 		{
-			for (auto& entity : Entities)
+			Clear();
+		}
+
+		/// <summary>
+		/// Saves every entity in the binary format described in SceneFormat.h.
+		/// </summary>
+		/// <returns>False if the file couldn't be written.</returns>
+		bool Save(const std::string& path)
+		{
+			EntityMemoryPool& pool = EntityMemoryPool::Instance();
+
+			// Skip entities that have been destroyed but are still waiting to be removed.
+			std::vector<Entity> entities;
+			entities.reserve(Entities.size());
+			std::copy_if(Entities.begin(), Entities.end(), std::back_inserter(entities), [](Entity entity) { return entity.IsAlive(); });
+
+			auto appendString = [](std::vector<char>& block, const std::string& string)
+			{
+				const uint32_t length = static_cast<uint32_t>(string.size());
+				block.insert(block.end(), reinterpret_cast<const char*>(&length), reinterpret_cast<const char*>(&length) + sizeof(length));
+				block.insert(block.end(), string.begin(), string.end());
+			};
+
+			std::vector<SceneFileComponent> table(ComponentHelper<Components>::Count);
+			std::vector<char> tags;
+			std::vector<uint64_t> enabled;
+			enabled.reserve(entities.size());
+			for (Entity entity : entities)
+			{
+				appendString(tags, TagTable::Instance().GetName(pool.GetTag(entity.ID)));
+				enabled.push_back(pool.GetEnabledComponents(entity.ID).to_ullong());
+			}
+
+			// Every texture name, so the sprites' handles can be mapped back to them.
+			std::vector<char> textures;
+			const TextureRegistry& textureRegistry = TextureRegistry::Instance();
+			for (size_t id = 0; id < textureRegistry.size(); ++id)
 			{
-				EntityMemoryPool::Instance().Destroy(entity.ID);
+				appendString(textures, textureRegistry.GetName(static_cast<TextureId>(id)));
 			}
+
+			SceneFileHeader header{};
+			std::memcpy(header.Magic, SCENE_FILE_MAGIC, sizeof(header.Magic));
+			header.Version = SCENE_FILE_VERSION;
+			header.EntityCount = entities.size();
+			header.ComponentTypeCount = static_cast<uint32_t>(table.size());
+			header.TagsOffset = sizeof(SceneFileHeader) + sizeof(SceneFileComponent) * table.size();
+			header.TagsSize = tags.size();
+			header.EnabledOffset = header.TagsOffset + header.TagsSize;
+			header.TexturesOffset = header.EnabledOffset + sizeof(uint64_t) * enabled.size();
+			header.TexturesSize = textures.size();
+
+			// Gather each component into its own contiguous column.
+			std::vector<std::vector<char>> columns(table.size());
+			uint64_t offset = header.TexturesOffset + header.TexturesSize;
+			ComponentHelper<Components>::ForEachType([&]<typename T, size_t Index>()
+			{
+				static_assert(std::is_trivially_copyable_v<T>, "Components are saved as raw bytes.");
+				static_assert(ComponentNames[Index].size() < sizeof(SceneFileComponent::Name));
+
+				SceneFileComponent& component = table[Index];
+				std::memcpy(component.Name, ComponentNames[Index].data(), ComponentNames[Index].size());
+				component.Size = sizeof(T);
+				component.Offset = offset;
+
+				std::vector<char>& column = columns[Index];
+				ComponentStorage<T>& storage = pool.GetStorage<T>();
+				for (size_t i = 0; i < entities.size(); ++i)
+				{
+					if (!(enabled[i] & (1ull << Index))) { continue; }
+
+					const T& value = storage.Get(entities[i].ID);
+					column.insert(column.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value) + sizeof(T));
+					++component.Count;
+				}
+				offset += column.size();
+			});
+
+			std::ofstream out{ path, std::ios::binary };
+			out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			out.write(reinterpret_cast<const char*>(table.data()), sizeof(SceneFileComponent) * table.size());
+			out.write(tags.data(), tags.size());
+			out.write(reinterpret_cast<const char*>(enabled.data()), sizeof(uint64_t) * enabled.size());
+			out.write(textures.data(), textures.size());
+			for (const std::vector<char>& column : columns)
+			{
+				out.write(column.data(), column.size());
+			}
+			return out.good();
 		}
 
-		void Save(const std::string& path)
+		/// <summary>
+		/// Replaces every entity with those in a file written by <see cref="Save"/>. The file is memory mapped and each
+		/// component column is copied straight into the memory pool.
+		/// </summary>
+		/// <returns>False if the file is missing, from a newer version or malformed, in which case no entities are changed.</returns>
+		bool Load(const std::string& path)
 		{
-			auto saveEntity = [](Entity entity, std::ofstream& out, EntityManager& manager)
+			// Version 1 headers end before the textures block's fields.
+			constexpr size_t FirstHeaderSize = offsetof(SceneFileHeader, TexturesOffset);
+
+			MappedFile file(path);
+			if (!file.IsOpen() || file.GetSize() < FirstHeaderSize) { return false; }
+
+			const std::byte* data = file.GetData();
+			const size_t size = file.GetSize();
+			auto isInFile = [size](uint64_t offset, uint64_t length) { return offset <= size && length <= size - offset; };
+
+			SceneFileHeader header{};
+			std::memcpy(&header, data, FirstHeaderSize);
+			if (std::memcmp(header.Magic, SCENE_FILE_MAGIC, sizeof(header.Magic)) != 0) { return false; }
+			if (header.Version > SCENE_FILE_VERSION) { return false; }
+
+			const size_t headerSize = header.Version >= 2 ? sizeof(SceneFileHeader) : FirstHeaderSize;
+			if (size < headerSize) { return false; }
+			std::memcpy(&header, data, headerSize);
+
+			if (header.ComponentTypeCount > MAX_COMPONENTS) { return false; }
+			if (!isInFile(headerSize, sizeof(SceneFileComponent) * uint64_t{ header.ComponentTypeCount })) { return false; }
+			if (!isInFile(header.TagsOffset, header.TagsSize)) { return false; }
+			if (header.EntityCount > size / sizeof(uint64_t) || !isInFile(header.EnabledOffset, sizeof(uint64_t) * header.EntityCount)) { return false; }
+			if (!isInFile(header.TexturesOffset, header.TexturesSize)) { return false; }
+
+			std::vector<SceneFileComponent> table(header.ComponentTypeCount);
+			std::memcpy(table.data(), data + headerSize, sizeof(SceneFileComponent) * table.size());
+			for (const SceneFileComponent& component : table)
 			{
-				size_t id = entity.GetID();
+				if (component.Size == 0 || component.Count > size / component.Size || !isInFile(component.Offset, component.Size * component.Count)) { return false; }
+			}
 
-				SerialisedData data
-				{
-					manager.GetEnabledComponents(id),
-					"\0",
-					manager.GetPoolSlice(id)
-				};
-				strcpy(data.Tag, entity.GetTag().c_str());
+			// Read the next length prefixed string from a block, or nothing if it runs past the end.
+			auto readString = [data](uint64_t blockOffset, uint64_t blockSize, uint64_t& offset) -> std::optional<std::string_view>
+			{
+				const char* block = reinterpret_cast<const char*>(data + blockOffset);
+				uint32_t length;
+				if (blockSize - offset < sizeof(length)) { return std::nullopt; }
+				std::memcpy(&length, block + offset, sizeof(length));
+				offset += sizeof(length);
 
-				out.write(reinterpret_cast<char*>(&data), sizeof(data));
+				if (blockSize - offset < length) { return std::nullopt; }
+				offset += length;
+				return std::string_view(block + offset - length, length);
 			};
 
-			// Each line is an entity.
-			std::ofstream out{ path };
+			// Read every tag up front so a malformed file is caught before anything is destroyed.
+			std::vector<std::string_view> tags;
+			tags.reserve(header.EntityCount);
+			uint64_t tagOffset = 0;
+			for (uint64_t i = 0; i < header.EntityCount; ++i)
+			{
+				std::optional<std::string_view> tag = readString(header.TagsOffset, header.TagsSize, tagOffset);
+				if (!tag) { return false; }
+				tags.push_back(*tag);
+			}
 
-			// Want to avoid new line at the end file so that loading is simpler.
-			saveEntity(Entities[0], out, *this);
-			for (int i = 1; i < Entities.size(); ++i)
+			// The texture handles in this session for those in the file.
+			std::vector<TextureId> textures;
+			uint64_t textureOffset = 0;
+			while (textureOffset < header.TexturesSize)
 			{
-				out << "\n";
-				saveEntity(Entities[i], out, *this);
+				std::optional<std::string_view> texture = readString(header.TexturesOffset, header.TexturesSize, textureOffset);
+				if (!texture) { return false; }
+				textures.push_back(TextureRegistry::Instance().GetId(*texture));
 			}
+
+			std::vector<uint64_t> fileEnabled(header.EntityCount);
+			std::memcpy(fileEnabled.data(), data + header.EnabledOffset, sizeof(uint64_t) * fileEnabled.size());
+
+			// Match the file's components to the current ones by name, so that the component list can change.
+			constexpr size_t NotLoaded = std::numeric_limits<size_t>::max();
+			std::array<size_t, ComponentHelper<Components>::Count> fileIndices;
+			fileIndices.fill(NotLoaded);
+			ComponentHelper<Components>::ForEachType([&]<typename T, size_t Index>()
+			{
+				for (size_t i = 0; i < table.size(); ++i)
+				{
+					const std::string_view name(table[i].Name, strnlen(table[i].Name, sizeof(table[i].Name)));
+					if (name == ComponentNames[Index] && table[i].Size == sizeof(T)) { fileIndices[Index] = i; }
+				}
+			});
+
+			// The memory pool is shared, so the existing entities need to be destroyed rather than forgotten.
+			Clear();
+
+			EntityMemoryPool& pool = EntityMemoryPool::Instance();
+			pool.Reserve(pool.GetEntityAliveCount() + header.EntityCount);
+
+			std::vector<size_t> ids;
+			ids.reserve(header.EntityCount);
+			for (uint64_t i = 0; i < header.EntityCount; ++i)
+			{
+				Entity entity = AddEntity(tags[i]);
+				ids.push_back(entity.ID);
+
+				std::bitset<MAX_COMPONENTS> enabled;
+				for (size_t component = 0; component < fileIndices.size(); ++component)
+				{
+					enabled[component] = fileIndices[component] != NotLoaded && (fileEnabled[i] & (1ull << fileIndices[component]));
+				}
+				pool.SetEnabledComponents(entity.ID, enabled);
+			}
+
+			ComponentHelper<Components>::ForEachType([&]<typename T, size_t Index>()
+			{
+				if (fileIndices[Index] == NotLoaded) { return; }
+
+				const uint64_t bit = 1ull << fileIndices[Index];
+				const std::byte* column = data + table[fileIndices[Index]].Offset;
+				const std::byte* columnEnd = column + table[fileIndices[Index]].Size * table[fileIndices[Index]].Count;
+				ComponentStorage<T>& storage = pool.GetStorage<T>();
+				if constexpr (!IsSparse<T> && !std::is_same_v<T, Sprite>)
+				{
+					// Nothing to remap, so runs of consecutive IDs with the component are copied straight from the file.
+					for (size_t i = 0; i < ids.size() && column < columnEnd;)
+					{
+						if (!(fileEnabled[i] & bit)) { ++i; continue; }
+
+						size_t count = 1;
+						while (i + count < ids.size() && ids[i + count] == ids[i] + count && (fileEnabled[i + count] & bit)) { ++count; }
+						count = std::min<size_t>(count, (columnEnd - column) / sizeof(T));
+						storage.CopyFrom(ids[i], column, count, pool.GetTick());
+						column += sizeof(T) * count;
+						i += count;
+					}
+					return;
+				}
+
+				for (size_t i = 0; i < ids.size() && column < columnEnd; ++i)
+				{
+					if (!(fileEnabled[i] & bit)) { continue; }
+
+					T& value = storage[ids[i]];
+					std::memcpy(&value, column, sizeof(T));
+					if constexpr (std::is_same_v<T, Sprite>)
+					{
+						value.Texture = value.Texture < textures.size() ? textures[value.Texture] : NoTexture;
+					}
+					storage.MarkChanged(ids[i], pool.GetTick());
+					column += sizeof(T);
+				}
+			});
+
+			return true;
 		}
 
-		void Load(const std::string& path)
+		/// <summary>
+		/// Start a new tick, removing destroyed entities and adding new ones to the lists and views.
+		/// </summary>
+		void Update()
 		{
-			std::ifstream in{ path };
+			EntityMemoryPool::Instance().AdvanceTick();
 
-			std::string line;
-			while (std::getline(in, line))
+			for (Entity entity : EntitiesToDestroy)
 			{
-				SerialisedData data;
-				std::istringstream string(line);
-				string.read(reinterpret_cast<char*>(&data), sizeof(data));
+				// The ID could have been reused, in which case the entity was removed when it was.
+				if (IsInLists(entity)) { RemoveFromLists(entity.ID); }
+			}
+			EntitiesToDestroy.clear();
 
-				Entity entity = AddEntity(data.Tag);
-				SetEnabledComponents(entity.GetID(), data.EnabledComponents);
-				SetPoolSlice(entity.GetID(), data.Slice);
+			for (Entity entity : EntitiesToAdd)
+			{
+				EntityLocation& location = Locations[entity.ID];
+				location.Index = Entities.size();
+				location.IsPending = false;
+				Entities.push_back(entity);
 			}
+			EntitiesToAdd.clear();
 
+			EntityMemoryPool::Instance().UpdateViews();
 		}
 
-		void Update()
+		/// <summary>
+		/// Destroys every entity, including those still waiting to be added. Unlike <see cref="Destroy"/> they're removed
+		/// from views straight away, so don't call this while iterating one.
+		/// </summary>
+		void Clear()
 		{
-			Entities.insert(Entities.end(), EntitiesToAdd.begin(), EntitiesToAdd.end());
+			// Entities waiting to be added have been given IDs and could have components enabled, so need destroying too.
+			// Those waiting on removal have already been destroyed. Destroyed IDs are reused last first, so destroying in
+			// reverse hands them out again in the same order, keeping loaded components in runs that can be copied at once.
+			for (auto entity = EntitiesToAdd.rbegin(); entity != EntitiesToAdd.rend(); ++entity)
+			{
+				if (entity->IsAlive()) { EntityMemoryPool::Instance().Destroy(entity->ID); }
+			}
+			for (auto entity = Entities.rbegin(); entity != Entities.rend(); ++entity)
+			{
+				if (entity->IsAlive()) { EntityMemoryPool::Instance().Destroy(entity->ID); }
+			}
+
+			Entities.clear();
 			EntitiesToAdd.clear();
+			EntitiesToDestroy.clear();
+			EntitiesByTag.clear();
+			Locations.clear();
+			EntityMemoryPool::Instance().UpdateViews();
 		}
 
 		std::vector<Entity>& GetEntities()
@@ -92,37 +382,93 @@ namespace Engine
 			return Entities;
 		}
 
-		std::vector<Entity>& GetEntitiesByTag(std::string tag)
+		/// <summary>
+		/// Get every entity that has at least the given components. Unlike <see cref="GetEntities"/> with a
+		/// HasComponents check this only iterates matching entities.
+		/// </summary>
+		/// <remarks>
+		/// Entities only join a view on <see cref="Update"/> so it's safe to add entities or components while iterating.
+		/// </remarks>
+		template<typename... T> requires (!(ChangedFilter<T>::IsFilter || ...))
+		EntityView GetView()
+		{
+			return EntityView(EntityMemoryPool::Instance().GetView<T...>());
+		}
+
+		/// <summary>
+		/// Get every entity that has at least the given components, where those wrapped in <see cref="Changed"/> have all
+		/// been changed on or after the given tick. By default that's the current tick, i.e. changed since the last
+		/// <see cref="Update"/>.
+		/// </summary>
+		template<typename... T> requires (ChangedFilter<T>::IsFilter || ...)
+		ChangedEntityView GetView(uint32_t since = EntityMemoryPool::Instance().GetTick())
 		{
-			// This automatically creates an entry if it doesn't exist, which could result in unintended allocations
-			// if there's a typo in the tag but this is neccesary to attempt to access entities before they might been created.
-			// TODO: I suppose with an enum instead of a string this'll prevent compilation with invalid tags.
+			return ChangedEntityView(EntityMemoryPool::Instance().GetView<typename ChangedFilter<T>::Component...>(), since,
+				[](size_t id, uint32_t since)
+				{
+					EntityMemoryPool& pool = EntityMemoryPool::Instance();
+					return ((!ChangedFilter<T>::IsFilter || pool.GetChangedTick<typename ChangedFilter<T>::Component>(id) >= since) && ...);
+				});
+		}
+
+		std::vector<Entity>& GetEntitiesByTag(TagId tag)
+		{
+			// Creates an entry if it doesn't exist, as it's necessary to access entities before they might have been created.
+			if (tag >= EntitiesByTag.size()) { EntitiesByTag.resize(tag + 1); }
 			return EntitiesByTag[tag];
 		}
 
-		Entity AddEntity(const std::string& tag)
+		/// <remarks>
+		/// Prefer the <see cref="TagId"/> overload with a constant from <see cref="Tags"/> where possible, this has to
+		/// look up the tag first.
+		/// </remarks>
+		std::vector<Entity>& GetEntitiesByTag(std::string_view tag)
+		{
+			return GetEntitiesByTag(TagTable::Instance().Intern(tag));
+		}
+
+		/// <summary>
+		/// Make room for at least the given number of entities across the memory pool.
+		/// </summary>
+		void Reserve(size_t capacity)
+		{
+			EntityMemoryPool::Instance().Reserve(capacity);
+		}
+
+		Entity AddEntity(std::string_view tag)
+		{
+			return AddEntity(TagTable::Instance().Intern(tag));
+		}
+
+		Entity AddEntity(TagId tag)
 		{
 			size_t id = EntityMemoryPool::Instance().AddEntity(tag);
 			Entity entity = Entity(id);
+
+			if (id >= Locations.size()) { Locations.resize(EntityMemoryPool::Instance().GetCapacity()); }
+
+			// The ID was destroyed this frame and is still waiting to be removed, so remove it now to keep IDs unique in
+			// the lists.
+			if (Locations[id].Index != EntityLocation::NotStored) { RemoveFromLists(id); }
+
+			std::vector<Entity>& sameTagEntities = GetEntitiesByTag(tag);
+			Locations[id] = { EntitiesToAdd.size(), sameTagEntities.size(), tag, true };
 			EntitiesToAdd.push_back(entity); // Add to a seperate vector to prevent resizing that could cause iterator invalidation when called from within loop.
-			EntitiesByTag[tag].push_back(entity);
+			sameTagEntities.push_back(entity);
 			return entity;
 		}
 
-		// TOOD: Could this cause iterator invalidation if done in a loop?
+		/// <summary>
+		/// Destroys the entity straight away, so its ID can be reused immediately, but it stays in the entity lists and
+		/// views until the next <see cref="Update"/>. This makes destroying while iterating them safe, and each removal
+		/// a constant time swap and pop.
+		/// </summary>
 		void Destroy(Entity entity)
 		{
-			// Remove from vectors.
-			std::erase(Entities, entity);
-			std::erase(EntitiesToAdd, entity);
-
-			// Remove from tag map.
-			const std::string& tag = EntityMemoryPool::Instance().GetTag(entity.ID);
-			std::vector<Entity>& SameTagEntities = EntitiesByTag[tag];
-			std::erase(SameTagEntities, entity);
+			if (!entity.IsAlive()) { return; } // Already destroyed, the ID could belong to a different entity now.
 
-			// Mark as destroyed.
 			EntityMemoryPool::Instance().Destroy(entity.ID);
+			EntitiesToDestroy.push_back(entity);
 		}
 
 		std::bitset<MAX_COMPONENTS> GetEnabledComponents(size_t id) const
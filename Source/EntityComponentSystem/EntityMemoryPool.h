@@ -1,11 +1,14 @@
 #pragma once
 #include "Components.h"
 #include "TupleHelper.h"
+#include "ChunkedVector.h"
+#include "Tag.h"
 #include <vector>
 #include <string>
 #include <tuple>
-#include <stack>
 #include <bitset>
+#include <deque>
+#include <limits>
 
 namespace Engine
 {
@@ -14,23 +17,46 @@ namespace Engine
 	/// </summary>
 	class EntityMemoryPool
 	{
-		#define MAX_ENTITIES 16384
+		#define INITIAL_ENTITY_CAPACITY 16384
 		#define MAX_COMPONENTS 64
 
 		size_t AliveCount = 0;
+		uint32_t CurrentTick = 1; // Starts after 0 so that a tick of 0 means never changed.
+		size_t Capacity = 0;
 		ComponentPool Pool; // Includes entity ID, and all its components.
-		std::vector<std::bitset<MAX_COMPONENTS>> EnabledComponents;
-		std::vector<std::string> Tags; // A category of entities, e.g. enemies. For maximum performance could use enum.
-		std::stack<size_t> AvailableIDs;
+		ComponentSlice ScratchSlice; // Stands in for sparse components an entity doesn't have, see GetReferenceSlice.
+		ChunkedVector<std::bitset<MAX_COMPONENTS>> EnabledComponents;
+		ChunkedVector<TagId> Tags; // A category of entities, e.g. enemies.
+		ChunkedVector<uint32_t> Generations; // Incremented on destruction so that handles to a destroyed entity can be detected.
+		ChunkedVector<bool> IsAlive;
+		std::vector<size_t> AvailableIDs; // Used as a stack, but new IDs need to be placed at the bottom when growing.
 
-		EntityMemoryPool(size_t maxEntities)
+		/// <summary>
+		/// A dense list of every entity that has at least the components in its signature, so that systems only iterate
+		/// what they need instead of checking every entity's enabled components.
+		/// </summary>
+		struct View
 		{
-			std::apply([maxEntities](auto&&... args) {((args.resize(maxEntities)), ...); }, Pool);
-			Tags = std::vector<std::string>(maxEntities);
-			EnabledComponents = std::vector<std::bitset<MAX_COMPONENTS>>(maxEntities);
+			static constexpr size_t NotInView = std::numeric_limits<size_t>::max();
 
-			for (size_t i = maxEntities - 1; i > 0; --i) { AvailableIDs.push(i); }
-			AvailableIDs.push(0); // Start from 0 for consistency.
+			std::bitset<MAX_COMPONENTS> Signature;
+			std::vector<size_t> Entities; // Dense, this is what gets iterated.
+			std::vector<size_t> Indices; // Sparse, entity ID to its index in Entities.
+		};
+
+		std::deque<View> Views; // Deque so that references to existing views survive new views being registered.
+
+		/// <summary>
+		/// Entities whose enabled components have changed since views were last updated. Adding to views is deferred so
+		/// that a view can't be resized while it's being iterated.
+		/// </summary>
+		std::vector<size_t> DirtyEntities;
+		std::vector<bool> IsDirty;
+		std::vector<size_t> DestroyedEntities; // Since views were last updated.
+
+		EntityMemoryPool(size_t capacity)
+		{
+			Reserve(capacity);
 		}
 
 		size_t GetNextEntityIndex()
@@ -44,15 +70,60 @@ namespace Engine
 			// Create 1, Delete 1, Undo (which creates 2), Undo (which tries to delete 1), leaving entity 2 incorrectly still in existence.
 			// When it should be:
 			// Create 1, Delete 1, Undo (which creates 1), Undo (which deletes 1)
-			size_t id = AvailableIDs.top();
-			AvailableIDs.pop();
+			if (AvailableIDs.empty()) { Reserve(Capacity * 2); }
+
+			size_t id = AvailableIDs.back();
+			AvailableIDs.pop_back();
 			return id;
 		}
 
+		void MarkDirty(size_t id)
+		{
+			if (IsDirty[id]) { return; }
+			IsDirty[id] = true;
+			DirtyEntities.push_back(id);
+		}
+
+		static void AddToView(View& view, size_t id)
+		{
+			view.Indices[id] = view.Entities.size();
+			view.Entities.push_back(id);
+		}
+
+		static void RemoveFromView(View& view, size_t id)
+		{
+			// Swap and pop so that removal doesn't need to shuffle the whole view down.
+			const size_t index = view.Indices[id];
+			const size_t last = view.Entities.back();
+			view.Entities[index] = last;
+			view.Indices[last] = index;
+			view.Entities.pop_back();
+			view.Indices[id] = View::NotInView;
+		}
+
+		View& RegisterView(std::bitset<MAX_COMPONENTS> signature)
+		{
+			for (View& view : Views)
+			{
+				if (view.Signature == signature) { return view; }
+			}
+
+			View& view = Views.emplace_back(signature);
+			view.Indices = std::vector<size_t>(Capacity, View::NotInView);
+
+			// Destroyed entities have no enabled components, so anything matching is alive.
+			for (size_t id = 0; id < Capacity; ++id)
+			{
+				if ((EnabledComponents[id] & signature) == signature) { AddToView(view, id); }
+			}
+
+			return view;
+		}
+
 	public:
 		static EntityMemoryPool& Instance()
 		{
-			static EntityMemoryPool pool(MAX_ENTITIES);
+			static EntityMemoryPool pool(INITIAL_ENTITY_CAPACITY);
 			return pool;
 		}
 		~EntityMemoryPool()
@@ -61,34 +132,144 @@ namespace Engine
 		}
 
 		size_t GetEntityAliveCount() const { return AliveCount; }
+		size_t GetCapacity() const { return Capacity; }
+
+		/// <summary>
+		/// Grow to hold at least the given number of entities, e.g. before loading a large map. The pool also grows
+		/// automatically when it runs out of IDs, but reserving up front avoids growing more than needed.
+		/// Existing components are never moved, so references to them stay valid.
+		/// </summary>
+		void Reserve(size_t capacity)
+		{
+			capacity = (capacity + ChunkedVector<bool>::CHUNK_SIZE - 1) / ChunkedVector<bool>::CHUNK_SIZE * ChunkedVector<bool>::CHUNK_SIZE; // Round up to whole chunks.
+			if (capacity <= Capacity) { return; }
 
-		size_t AddEntity(const std::string& tag)
+			std::apply([capacity](auto&&... args) {((args.Resize(capacity)), ...); }, Pool);
+			Tags.Resize(capacity);
+			EnabledComponents.Resize(capacity);
+			Generations.Resize(capacity);
+			IsAlive.Resize(capacity);
+			IsDirty.resize(capacity);
+			for (View& view : Views) { view.Indices.resize(capacity, View::NotInView); }
+
+			// New IDs go to the bottom of the stack so that destroyed IDs are still reused first, with the lowest new ID on top.
+			std::vector<size_t> newIDs;
+			for (size_t i = capacity; i > Capacity; --i) { newIDs.push_back(i - 1); }
+			AvailableIDs.insert(AvailableIDs.begin(), newIDs.begin(), newIDs.end());
+
+			Capacity = capacity;
+		}
+
+		size_t AddEntity(TagId tag)
 		{
 			size_t index = GetNextEntityIndex();
 
-			std::apply([index](auto&&... args) {((args[index] = {}), ...); }, Pool); // Reset values of each component that belongs to this entity.
+			std::apply([index](auto&&... args) {((args.Reset(index)), ...); }, Pool); // Reset values of each component that belongs to this entity.
 			Tags[index] = tag;
+			IsAlive[index] = true;
 			AliveCount++;
 			return index;
 		}
 
+		uint32_t GetGeneration(size_t id) const
+		{
+			return Generations[id];
+		}
+
+		/// <returns>Whether the entity with the given ID and generation hasn't been destroyed.</returns>
+		bool IsValid(size_t id, uint32_t generation) const
+		{
+			return IsAlive[id] && Generations[id] == generation;
+		}
+
+		template<typename... T>
+		static std::bitset<MAX_COMPONENTS> GetSignature()
+		{
+			return (... + []()
+			{
+				return (1 << tuple_element_index_v<ComponentStorage<T>, ComponentPool>);
+			}());
+		}
+
 		template <typename T>
 		void AddComponent(size_t id)
 		{
-			constexpr std::size_t index = tuple_element_index_v<std::vector<T>, ComponentPool>;
+			constexpr std::size_t index = tuple_element_index_v<ComponentStorage<T>, ComponentPool>;
 			EnabledComponents[id] |= 1 << index;
+			std::get<ComponentStorage<T>>(Pool)[id]; // Sparse storage needs a component stored before it can be accessed from multiple threads.
+			std::get<ComponentStorage<T>>(Pool).MarkChanged(id, CurrentTick); // Being added counts as a change.
+			MarkDirty(id);
+		}
+
+		template <typename T>
+		void RemoveComponent(size_t id)
+		{
+			constexpr std::size_t index = tuple_element_index_v<ComponentStorage<T>, ComponentPool>;
+			EnabledComponents[id][index] = false;
+			std::get<ComponentStorage<T>>(Pool).Remove(id);
+			MarkDirty(id);
 		}
 
+		/// <remarks>
+		/// Only for components the entity has, as a sparsely stored one would be stored otherwise. As the component can be
+		/// changed through the reference it's marked as changed, use <see cref="ReadComponent"/> when only reading.
+		/// </remarks>
 		template <typename T>
 		T& GetComponent(size_t id)
 		{
-			return std::get<std::vector<T>>(Pool)[id];
+			ComponentStorage<T>& storage = std::get<ComponentStorage<T>>(Pool);
+			T& component = storage[id];
+			storage.MarkChanged(id, CurrentTick);
+			return component;
+		}
+
+		/// <summary>
+		/// Get a component without marking it as changed. Never stores anything, so is safe to call from several threads.
+		/// </summary>
+		/// <remarks>
+		/// A sparsely stored component the entity doesn't have reads as a default component.
+		/// </remarks>
+		template <typename T>
+		const T& ReadComponent(size_t id) const
+		{
+			return std::get<ComponentStorage<T>>(Pool).Get(id);
+		}
+
+		template <typename T>
+		void MarkChanged(size_t id)
+		{
+			std::get<ComponentStorage<T>>(Pool).MarkChanged(id, CurrentTick);
+		}
+
+		template <typename T>
+		uint32_t GetChangedTick(size_t id) const
+		{
+			return std::get<ComponentStorage<T>>(Pool).GetChangedTick(id);
+		}
+
+		/// <summary>
+		/// Components changed since the last call to <see cref="AdvanceTick"/> are stamped with this.
+		/// </summary>
+		uint32_t GetTick() const { return CurrentTick; }
+
+		/// <summary>
+		/// Start a new tick, called once a frame by <see cref="EntityManager::Update"/>.
+		/// </summary>
+		void AdvanceTick() { ++CurrentTick; }
+
+		/// <summary>
+		/// Direct access to how a component is stored, e.g. for a linear scan over a sparsely stored component.
+		/// </summary>
+		template <typename T>
+		ComponentStorage<T>& GetStorage()
+		{
+			return std::get<ComponentStorage<T>>(Pool);
 		}
 
 		template <typename T>
 		bool HasComponent(size_t id)
 		{
-			const std::bitset<MAX_COMPONENTS> requiredComponents = (1 << tuple_element_index_v<std::vector<T>, ComponentPool>);
+			const std::bitset<MAX_COMPONENTS> requiredComponents = (1 << tuple_element_index_v<ComponentStorage<T>, ComponentPool>);
 
 			auto componentsInBoth = requiredComponents & EnabledComponents[id];
 			if (componentsInBoth == requiredComponents) { return true; }
@@ -98,17 +279,14 @@ namespace Engine
 		template<typename... T>
 		bool HasComponents(size_t id)
 		{
-			std::bitset<MAX_COMPONENTS> requiredComponents = (... + []()
-			{
-				return (1 << tuple_element_index_v<std::vector<T>, ComponentPool>);
-			}());
+			const std::bitset<MAX_COMPONENTS> requiredComponents = GetSignature<T...>();
 
 			auto componentsInBoth = requiredComponents & EnabledComponents[id];
 			if (componentsInBoth == requiredComponents) { return true; }
 			return false;
 		}
 
-		const std::string& GetTag(size_t id) const
+		TagId GetTag(size_t id) const
 		{
 			return Tags[id];
 		}
@@ -117,7 +295,14 @@ namespace Engine
 		{
 			AliveCount--;
 			EnabledComponents[id] = 0;
-			AvailableIDs.push(id);
+			IsAlive[id] = false;
+			Generations[id]++;
+			AvailableIDs.push_back(id);
+
+			// Leaving views and freeing sparsely stored components waits until UpdateViews, so that destroying an entity
+			// while iterating a view doesn't shuffle the view or pull components out from under it.
+			MarkDirty(id);
+			DestroyedEntities.push_back(id);
 		}
 
 		std::bitset<MAX_COMPONENTS> GetEnabledComponents(size_t id) const
@@ -125,14 +310,58 @@ namespace Engine
 			return EnabledComponents[id];
 		}
 
+		/// <summary>
+		/// As the components can be enabled or disabled through the returned reference the entity's views will be
+		/// updated on the next call to <see cref="UpdateViews"/>.
+		/// </summary>
 		std::bitset<MAX_COMPONENTS>& GetEnabledComponents(size_t id)
 		{
+			MarkDirty(id);
 			return EnabledComponents[id];
 		}
 
 		void SetEnabledComponents(size_t id, std::bitset<MAX_COMPONENTS> enabledComponents)
 		{
 			EnabledComponents[id] = enabledComponents;
+			MarkDirty(id);
+		}
+
+		/// <returns>The IDs of every entity with at least the given components, as of the last call to <see cref="UpdateViews"/>.
+		/// This will include entities alive in other loaded scenes.</returns>
+		template<typename... T>
+			requires (sizeof...(T) > 0)
+		const std::vector<size_t>& GetView()
+		{
+			// Registering is done once per signature, after which the view is kept up to date as components change.
+			static View& view = RegisterView(GetSignature<T...>());
+			return view.Entities;
+		}
+
+		/// <summary>
+		/// Add and remove entities from views depending on their currently enabled components, and free the sparsely stored
+		/// components of destroyed entities.
+		/// </summary>
+		void UpdateViews()
+		{
+			for (size_t id : DestroyedEntities)
+			{
+				if (IsAlive[id]) { continue; } // Reused since, so components were already reset.
+				std::apply([id](auto&&... args) {((args.Remove(id)), ...); }, Pool); // Free sparsely stored components.
+			}
+			DestroyedEntities.clear();
+
+			for (size_t id : DirtyEntities)
+			{
+				IsDirty[id] = false;
+				for (View& view : Views)
+				{
+					const bool isMatch = (EnabledComponents[id] & view.Signature) == view.Signature;
+					const bool isInView = view.Indices[id] != View::NotInView;
+					if (isMatch && !isInView) { AddToView(view, id); }
+					else if (!isMatch && isInView) { RemoveFromView(view, id); }
+				}
+			}
+			DirtyEntities.clear();
 		}
 
 		ComponentSlice CreateSlice(size_t id)
@@ -140,16 +369,31 @@ namespace Engine
 			return ComponentHelper<Components>::CreateSlice(Pool, id);
 		}
 
+		/// <remarks>
+		/// Enabled components should be set first, as sparsely stored components are only copied if they're enabled.
+		/// </remarks>
 		void UpdatePoolWithSlice(size_t id, ComponentSlice& componentSlice)
 		{
-			auto copyComponentToPool = []<typename T>(T& component, size_t id, ComponentPool& pool) { std::get<std::vector<T>>(pool)[id] = component; };
-			auto copyComponentsToPool = [&copyComponentToPool, id, this]<typename... T>(T&... component) { (copyComponentToPool(component, id, Pool), ...); };
+			auto copyComponentToPool = [this]<typename T>(T& component, size_t id)
+			{
+				// Don't store disabled sparse components, otherwise every slice would fill the sparse storage.
+				if constexpr (IsSparse<T>) { if (!HasComponent<T>(id)) { return; } }
+				GetComponent<T>(id) = component;
+			};
+			auto copyComponentsToPool = [&copyComponentToPool, id]<typename... T>(T&... component) { (copyComponentToPool(component, id), ...); };
 			std::apply(copyComponentsToPool, componentSlice);
 		}
 
+		/// <remarks>
+		/// Every component is marked as changed, as they can all be changed through the references. Sparsely stored
+		/// components the entity doesn't have refer to a scratch default instead, so selecting an entity in the editor
+		/// doesn't store them. Edits to those are lost, and the references only last until the next call.
+		/// </remarks>
 		ComponentReferenceSlice GetReferenceSlice(size_t id)
 		{
-			return ComponentHelper<Components>::CreateReferenceSlice(Pool, id);
+			ComponentReferenceSlice slice = ComponentHelper<Components>::CreateReferenceSlice(Pool, id, EnabledComponents[id], ScratchSlice);
+			std::apply([this, id](auto&... storage) { (storage.MarkChanged(id, CurrentTick), ...); }, Pool);
+			return slice;
 		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+#include "Entity.h"
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Used in place of a component in <see cref="EntityManager::GetView"/> to only get entities whose component has
+	/// changed, e.g. GetView&lt;Changed&lt;Position&gt;, Sprite&gt;().
+	/// </summary>
+	template<typename T>
+	struct Changed {};
+
+	template<typename T>
+	struct ChangedFilter
+	{
+		using Component = T;
+		static constexpr bool IsFilter = false;
+	};
+
+	template<typename T>
+	struct ChangedFilter<Changed<T>>
+	{
+		using Component = T;
+		static constexpr bool IsFilter = true;
+	};
+
+	/// <summary>
+	/// A read only range over the entities in one of the <see cref="EntityMemoryPool"/>'s views, handing out entities
+	/// rather than their raw IDs.
+	/// </summary>
+	class EntityView
+	{
+		const std::vector<size_t>& IDs;
+
+	public:
+		EntityView(const std::vector<size_t>& ids) : IDs(ids) {}
+
+		class Iterator
+		{
+			std::vector<size_t>::const_iterator Current;
+
+		public:
+			Iterator(std::vector<size_t>::const_iterator current) : Current(current) {}
+
+			Entity operator*() const { return Entity(*Current); }
+			Iterator& operator++() { ++Current; return *this; }
+			bool operator!=(const Iterator& right) const { return Current != right.Current; }
+		};
+
+		Iterator begin() const { return Iterator(IDs.begin()); }
+		Iterator end() const { return Iterator(IDs.end()); }
+		size_t size() const { return IDs.size(); }
+		bool empty() const { return IDs.empty(); }
+		Entity operator[](size_t index) const { return Entity(IDs[index]); }
+	};
+
+	/// <summary>
+	/// An <see cref="EntityView"/> that skips entities whose <see cref="Changed"/> components haven't been changed on or
+	/// after a given tick. Entities are checked as they're iterated, so there's no size.
+	/// </summary>
+	class ChangedEntityView
+	{
+	public:
+		using Filter = bool (*)(size_t id, uint32_t since);
+
+	private:
+		const std::vector<size_t>& IDs;
+		uint32_t Since;
+		Filter IsChanged;
+
+	public:
+		ChangedEntityView(const std::vector<size_t>& ids, uint32_t since, Filter isChanged) : IDs(ids), Since(since), IsChanged(isChanged) {}
+
+		class Iterator
+		{
+			std::vector<size_t>::const_iterator Current;
+			std::vector<size_t>::const_iterator End;
+			const ChangedEntityView* View;
+
+			void SkipUnchanged()
+			{
+				while (Current != End && !View->IsChanged(*Current, View->Since)) { ++Current; }
+			}
+
+		public:
+			Iterator(std::vector<size_t>::const_iterator current, std::vector<size_t>::const_iterator end, const ChangedEntityView* view)
+				: Current(current), End(end), View(view)
+			{
+				SkipUnchanged();
+			}
+
+			Entity operator*() const { return Entity(*Current); }
+			Iterator& operator++() { ++Current; SkipUnchanged(); return *this; }
+			bool operator!=(const Iterator& right) const { return Current != right.Current; }
+		};
+
+		Iterator begin() const { return Iterator(IDs.begin(), IDs.end(), this); }
+		Iterator end() const { return Iterator(IDs.end(), IDs.end(), this); }
+		bool empty() const { return !(begin() != end()); }
+	};
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+namespace Engine
+{
+	// Binary scene file layout, all little endian:
+	// SceneFileHeader
+	// SceneFileComponent * ComponentTypeCount, the component-type table.
+	// Tags block: for each entity a uint32_t length followed by that many characters.
+	// Enabled block: for each entity a uint64_t mask, where bit i is component i of the component-type table.
+	// Textures block (version 2 onwards): for each TextureId in order a uint32_t length followed by the texture's name.
+	// A column block per component type: the raw bytes of the component for every entity that has it enabled, in
+	// entity order.
+	//
+	// Components are matched by name when loading, so components can be added, removed or reordered without breaking
+	// old saves. A component whose size has changed can't be loaded, so is left as default. Texture handles in sprites
+	// are only valid for the session that saved them, so are mapped back through their names when loading.
+
+	/// <summary>
+	/// Bump whenever the layout changes, and keep loading older versions where possible.
+	/// </summary>
+	inline constexpr uint32_t SCENE_FILE_VERSION = 2;
+	inline constexpr char SCENE_FILE_MAGIC[4] = { 'S', 'C', 'N', 'E' };
+
+	struct SceneFileHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t EntityCount;
+		uint32_t ComponentTypeCount;
+		uint32_t Padding;
+		uint64_t TagsOffset;
+		uint64_t TagsSize;
+		uint64_t EnabledOffset;
+
+		// Added in version 2, older headers end before these.
+		uint64_t TexturesOffset;
+		uint64_t TexturesSize;
+	};
+
+	struct SceneFileComponent
+	{
+		char Name[32];
+		uint32_t Size; // sizeof the component when saved.
+		uint32_t Padding;
+		uint64_t Offset; // From the start of the file.
+		uint64_t Count; // Number of entities with the component.
+	};
+}
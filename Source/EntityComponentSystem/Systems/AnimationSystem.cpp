@@ -14,10 +14,26 @@ namespace Engine
 
 	void AnimationSystem::Update(const float& deltaTime)
 	{
-		for (Entity entity : OwningScene.GetEntityManager().GetEntities())
+		UpdateRange(deltaTime, 0, GetWorkSize());
+	}
+
+	SystemAccess AnimationSystem::GetAccess() const
+	{
+		return SystemAccess().Read<Velocity>().Write<Sprite, Animation>();
+	}
+
+	size_t AnimationSystem::GetWorkSize()
+	{
+		return OwningScene.GetEntityManager().GetView<Velocity, Sprite, Animation>().size();
+	}
+
+	void AnimationSystem::UpdateRange(const float& deltaTime, size_t begin, size_t end)
+	{
+		EntityView view = OwningScene.GetEntityManager().GetView<Velocity, Sprite, Animation>();
+		for (size_t i = begin; i < end; ++i)
 		{
-			if (!entity.HasComponents<Velocity, Sprite, Animation>()) { continue; }
-			Velocity& velocity = entity.GetComponent<Velocity>();
+			Entity entity = view[i];
+			const Velocity& velocity = entity.ReadComponent<Velocity>();
 			Sprite& sprite = entity.GetComponent<Sprite>();
 			Animation& animation = entity.GetComponent<Animation>();
 
@@ -12,6 +12,9 @@ namespace Engine
 		AnimationSystem(BaseScene& scene);
 
 		void Update(const float& deltaTime) override;
+		SystemAccess GetAccess() const override;
+		size_t GetWorkSize() override;
+		void UpdateRange(const float& deltaTime, size_t begin, size_t end) override;
 	private:
 		BaseScene& OwningScene;
 
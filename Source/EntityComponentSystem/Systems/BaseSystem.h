@@ -1,11 +1,69 @@
 #pragma once
+#include "../EntityMemoryPool.h"
+#include <bitset>
+
 namespace Engine
 {
+	/// <summary>
+	/// The components a system reads and writes, so that the scheduler knows which systems can run at the same time.
+	/// </summary>
+	struct SystemAccess
+	{
+		std::bitset<MAX_COMPONENTS> Reads;
+		std::bitset<MAX_COMPONENTS> Writes;
+		bool IsExclusive = false; // Touches state other than components, so can't run alongside any other system.
+
+		template<typename... T>
+		SystemAccess& Read()
+		{
+			Reads |= EntityMemoryPool::GetSignature<T...>();
+			return *this;
+		}
+
+		template<typename... T>
+		SystemAccess& Write()
+		{
+			Writes |= EntityMemoryPool::GetSignature<T...>();
+			return *this;
+		}
+
+		static SystemAccess Exclusive()
+		{
+			SystemAccess access;
+			access.IsExclusive = true;
+			return access;
+		}
+
+		/// <returns>True if running both systems at the same time could race.</returns>
+		bool ConflictsWith(const SystemAccess& other) const
+		{
+			if (IsExclusive || other.IsExclusive) { return true; }
+			return (Writes & (other.Reads | other.Writes)).any() || (other.Writes & Reads).any();
+		}
+	};
+
 	// TODO: Mayhap the OwningScene should be stored here, and a CTOR takes it in.
 	class BaseSystem
 	{
 	public:
 		virtual ~BaseSystem() = default;
 		virtual void Update(const float& deltaTime) = 0;
+
+		/// <summary>
+		/// Systems that don't declare what they access are assumed to access everything, so are run on their own.
+		/// </summary>
+		virtual SystemAccess GetAccess() const { return SystemAccess::Exclusive(); }
+
+		/// <returns>How many independent items of work an update can be split into, e.g. the size of the view being
+		/// iterated. 0 if the update can't be split.</returns>
+		/// <remarks>
+		/// Called before any system runs in a frame, so it's also the place to register views.
+		/// </remarks>
+		virtual size_t GetWorkSize() { return 0; }
+
+		/// <summary>
+		/// Update only the items of work in [begin, end). May be called from several threads at once with different ranges.
+		/// </summary>
+		virtual void UpdateRange(const float& deltaTime, size_t /*begin*/, size_t /*end*/) { Update(deltaTime); }
 	};
-}
\ No newline at end of file
+}
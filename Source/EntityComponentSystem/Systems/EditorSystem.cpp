@@ -41,13 +41,16 @@ namespace Engine
 
 	std::optional<Entity> EditorSystem::GetCollidingEntity(Vector2<float> position, Vector2<float> bounds)
 	{
-		for (auto& entity : OwningScene.GetEntityManager().GetEntitiesByTag("TileSet"))
+		// Any entity whose bounds overlap has a position within the bounds of this one.
+		for (Entity entity : OwningScene.ManagedSpatialHash.QueryRectangle({ position - bounds, bounds * 2 }))
 		{
-			// As the entities are retrieved by tags components can be assumed.
+			if (!entity.IsAlive()) { continue; } // Destroyed this frame, but not removed until the next update.
+			if (entity.GetTag() != Tags::TileSet) { continue; }
+
 			auto collision = Collision::RectangleIntersection
 			(
 				{ position, bounds },
-				{ entity.GetComponent<Position>(), bounds }
+				{ entity.ReadComponent<Position>(), bounds }
 			);
 
 			if (collision)
@@ -200,17 +203,15 @@ namespace Engine
 			ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
 
 		// Draw colliders
-		for (auto& entity : OwningScene.GetEntityManager().GetEntities())
+		for (Entity entity : OwningScene.GetEntityManager().GetView<Collider, Position, Sprite>())
 		{
-			if (!entity.HasComponents<Collider, Position, Sprite>()) { continue; }
-
-			Collider& collider = entity.GetComponent<Collider>();
+			const Collider& collider = entity.ReadComponent<Collider>();
 			std::vector<Vector2<float>> collisionPoints(collider.Points.begin(), collider.Points.begin() + collider.NumberOfPoints); // Sequence of nodes to form edge of collider.
 
 			if (collisionPoints.empty()) { continue; }
 
-			Position& position = entity.GetComponent<Position>();
-			Sprite& sprite = entity.GetComponent<Sprite>();
+			const Position& position = entity.ReadComponent<Position>();
+			const Sprite& sprite = entity.ReadComponent<Sprite>();
 			for (auto it = collisionPoints.cbegin(); it != collisionPoints.cend() - 1; ++it)
 			{
 				Vector2<float> point0 = OwningScene.WorldSpaceToRenderSpace(*it + position - sprite.PivotOffset);
@@ -224,12 +225,13 @@ namespace Engine
 		{
 			// TODO: This is quite awkward because the start and goal need to be a particular distance apart for the neighbour checking.
 			// It might make more sense to use the grid position, but that'll need conversion inside the function to handle collisions.
-			Position& playerPosition = OwningScene.GetEntityManager().GetEntitiesByTag("Player")[0].GetComponent<Position>();
+			const Position& playerPosition = OwningScene.GetEntityManager().GetEntitiesByTag(Tags::Player)[0].ReadComponent<Position>();
 			const Vector2<int> start = static_cast<Vector2<int>>(OwningScene.WorldSpaceToGrid({playerPosition.X, playerPosition.Y}));
 			const Vector2<int> goal = static_cast<Vector2<int>>(OwningScene.ScreenSpaceToGrid(ImGui::GetMousePos()));
 
-			auto cameFrom = OwningScene.ManagedNavigationGraph.AStar(start, goal);
-			auto path = OwningScene.ManagedNavigationGraph.ConstructPath(cameFrom, start, goal);
+			// Cached, so it's only searched again once either end moves to another cell or the colliders change.
+			std::vector<Vector2<int>> path;
+			OwningScene.ManagedNavigationGraph.FindPath(start, goal, path);
 
 			for (int i = 1; i < path.size(); ++i)
 			{
@@ -266,7 +268,7 @@ namespace Engine
 					}
 				}
 				ImGui::TableNextColumn();
-				ImGui::Text("%s", entity.GetTag().c_str());
+				ImGui::Text("%s", entity.GetTagName().c_str());
 			}
 
 			ImGui::EndTable();
@@ -285,11 +287,11 @@ namespace Engine
 		ImGui::InputInt("Entity Count:", &numberOfEntities);
 
 		EntityManager& entityManager = OwningScene.GetEntityManager();
-		std::vector<Entity>& testNPCs = entityManager.GetEntitiesByTag("TestNPC");
+		std::vector<Entity>& testNPCs = entityManager.GetEntitiesByTag(Tags::TestNPC);
 
 		for (int i = testNPCs.size(); i < numberOfEntities; ++i) // Spawn new entities.
 		{
-			Entity entity = entityManager.AddEntity("TestNPC");
+			Entity entity = entityManager.AddEntity(Tags::TestNPC);
 			entity.AddComponent<Position>();
 			entity.AddComponent<Velocity>();
 			entity.AddComponent<Sprite>();
@@ -304,7 +306,7 @@ namespace Engine
 			velocity.Direction.Y = std::sin(angleIncrements * (i % segments));
 
 			Sprite& sprite = entity.GetComponent<Sprite>();
-			strcpy(sprite.TextureName, "AnimationSheet.png");
+			sprite.Texture = TextureRegistry::Instance().GetId("AnimationSheet.png");
 			sprite.SourceRectangle = { {}, OwningScene.TileSize };
 			sprite.PivotOffset = { static_cast<float>(OwningScene.TileSize.X) / 2.f, static_cast<float>(OwningScene.TileSize.Y) / 1.5f };
 		}
@@ -10,14 +10,35 @@ namespace Engine
 
 	void MovementSystem::Update(const float& deltaTime)
 	{
-		for (auto& entity : OwningScene.GetEntityManager().GetEntities())
+		UpdateRange(deltaTime, 0, GetWorkSize());
+	}
+
+	SystemAccess MovementSystem::GetAccess() const
+	{
+		return SystemAccess().Read<Velocity>().Write<Position>();
+	}
+
+	size_t MovementSystem::GetWorkSize()
+	{
+		return OwningScene.GetEntityManager().GetView<Position, Velocity>().size();
+	}
+
+	void MovementSystem::UpdateRange(const float& deltaTime, size_t begin, size_t end)
+	{
+		EntityView view = OwningScene.GetEntityManager().GetView<Position, Velocity>();
+		for (size_t i = begin; i < end; ++i)
 		{
-			if (!entity.HasComponents<Position, Velocity>()) { return; }
+			Entity entity = view[i];
+			const Velocity& velocity = entity.ReadComponent<Velocity>();
+
+			// Entities standing still aren't written to, so they aren't marked as changed and aren't re-sorted or redrawn.
+			if (velocity.Speed == 0 || velocity.Direction == Vector2<float>{}) { continue; }
 
+			// Normalise a copy so velocity is only read, letting systems that read it run at the same time.
+			Vector2<float> direction = velocity.Direction;
+			direction.Normalise();
 			Position& position = entity.GetComponent<Position>();
-			Velocity& velocity = entity.GetComponent<Velocity>();
-			velocity.Direction.Normalise();
-			position += velocity.Direction * velocity.Speed * deltaTime;
+			position += direction * velocity.Speed * deltaTime;
 
 			// Just for testing.
 			if (position.LengthSquared() > 1024 * 1024)
@@ -10,17 +10,34 @@ namespace Engine
 	}
 
 	void PathfindingSystem::Update(const float& deltaTime)
+	{
+		UpdateRange(deltaTime, 0, GetWorkSize());
+	}
+
+	SystemAccess PathfindingSystem::GetAccess() const
+	{
+		// Path requests and the paths solved for each entity are kept by the scene, and only processed between runs.
+		return SystemAccess().Write<Position, Velocity, Pathfinding>();
+	}
+
+	size_t PathfindingSystem::GetWorkSize()
+	{
+		return OwningScene.GetEntityManager().GetView<Position, Velocity, Pathfinding>().size();
+	}
+
+	void PathfindingSystem::UpdateRange(const float& deltaTime, size_t begin, size_t end)
 	{
 		IsometricScene* scene = dynamic_cast<IsometricScene*>(&OwningScene);
 		if (!scene) { return; }
 
-		for (Entity entity : OwningScene.GetEntityManager().GetEntities())
+		EntityView view = OwningScene.GetEntityManager().GetView<Position, Velocity, Pathfinding>();
+		for (size_t i = begin; i < end; ++i)
 		{
-			if (!entity.HasComponents<Position, Velocity, Pathfinding>()) { continue; }
+			Entity entity = view[i];
 
-			Pathfinding& pathfinding = entity.GetComponent<Pathfinding>();
-			Position& position = entity.GetComponent<Position>();
-			Velocity& velocity = entity.GetComponent<Velocity>();
+			// Only read until something needs writing, so that entities waiting on a path aren't marked as changed.
+			const Pathfinding& pathfinding = entity.ReadComponent<Pathfinding>();
+			const Position& position = entity.ReadComponent<Position>();
 
 			Vector2<float> currentPosition = Vector2<float>{ position.X, position.Y };
 
@@ -35,19 +52,16 @@ namespace Engine
 
 				Vector2<float> targetPosition = Vector2<float>{ pathfinding.Current->X, pathfinding.Current->Y };
 
-
-				SDL_Log("Current: %f, %f", currentPosition.X, currentPosition.Y);
-				SDL_Log("Target: %f, %f", targetPosition.X, targetPosition.Y);
-
 				if (almostEquals(targetPosition.X, currentPosition.X) &&
 					almostEquals(targetPosition.Y, currentPosition.Y))
 				{
-					velocity.Speed = 0;
-					pathfinding.Current = std::nullopt;
+					entity.GetComponent<Velocity>().Speed = 0;
+					entity.GetComponent<Pathfinding>().Current = std::nullopt;
 
 					// Just ensure it's exactly in the correct place. Should help prevent floating point errors adding up.
-					position.X = targetPosition.X;
-					position.Y = targetPosition.Y;
+					Position& snappedPosition = entity.GetComponent<Position>();
+					snappedPosition.X = targetPosition.X;
+					snappedPosition.Y = targetPosition.Y;
 				}
 			}
 			else
@@ -57,16 +71,35 @@ namespace Engine
 
 				if (start == goal) { continue; }
 
-				auto edges = scene->ManagedNavigationGraph.AStar(start, goal);
-				auto path = scene->ManagedNavigationGraph.ConstructPath(edges, start, goal);
-
-				if (edges.size() > 1)
+				auto headTowards = [&](Vector2<int> node)
 				{
+					Velocity& velocity = entity.GetComponent<Velocity>();
 					velocity.Speed = 256;
-					velocity.Direction = static_cast<Vector2<float>>(path[1] - static_cast<Vector2<int>>(currentPosition));
+					velocity.Direction = static_cast<Vector2<float>>(node - static_cast<Vector2<int>>(currentPosition));
 					velocity.Direction.Normalise();
-					pathfinding.Current = static_cast<Vector2<float>>(path[1]);
+					entity.GetComponent<Pathfinding>().Current = static_cast<Vector2<float>>(node);
+				};
+
+				// When a crowd is heading to the goal there's a flow field to it, which gives the next step directly.
+				const NavigationGraph& graph = scene->ManagedNavigationGraph;
+				if (const FlowField* field = graph.FindFlowField(goal))
+				{
+					if (std::optional<Vector2<int>> next = field->GetNext(start)) { headTowards(graph.GetNode(*next)); }
+					continue;
 				}
+
+				// Otherwise follow the path solved for this entity, unless it's for a different goal or the map has changed
+				// since. Searches are left to the request queue, which solves them between frames.
+				PathRequestQueue::Path* path = scene->ManagedPathRequests.GetPath(entity);
+				const bool isCurrent = path && path->Goal == goal && path->Version == graph.GetVersion();
+				if (!isCurrent || (!path->Nodes.empty() && path->Next >= path->Nodes.size()))
+				{
+					scene->ManagedPathRequests.Request(entity, start, goal);
+					continue;
+				}
+				if (path->Nodes.empty()) { continue; } // No way to the goal.
+
+				headTowards(path->Nodes[path->Next++]);
 			}
 		}
 	}
@@ -11,6 +11,9 @@ namespace Engine
 	public:
 		PathfindingSystem(BaseScene& scene);
 		void Update(const float& deltaTime) override;
+		SystemAccess GetAccess() const override;
+		size_t GetWorkSize() override;
+		void UpdateRange(const float& deltaTime, size_t begin, size_t end) override;
 	private:
 		BaseScene& OwningScene;
 	};
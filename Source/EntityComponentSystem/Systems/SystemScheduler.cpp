@@ -0,0 +1,121 @@
+#include "SystemScheduler.h"
+#include <algorithm>
+
+namespace Engine
+{
+	void SystemScheduler::Build(const std::vector<std::unique_ptr<BaseSystem>>& systems)
+	{
+		Nodes = std::vector<Node>(systems.size());
+
+		std::vector<SystemAccess> access;
+		access.reserve(systems.size());
+		for (size_t i = 0; i < systems.size(); ++i)
+		{
+			Nodes[i].System = systems[i].get();
+			access.push_back(systems[i]->GetAccess());
+		}
+
+		// Systems added later wait on any earlier system they conflict with, so order is kept where it matters.
+		for (size_t later = 0; later < Nodes.size(); ++later)
+		{
+			for (size_t earlier = 0; earlier < later; ++earlier)
+			{
+				if (!access[earlier].ConflictsWith(access[later])) { continue; }
+
+				Nodes[earlier].Dependents.push_back(later);
+				++Nodes[later].DependencyCount;
+			}
+		}
+	}
+
+	void SystemScheduler::Queue(size_t node)
+	{
+		Node& current = Nodes[node];
+
+		// Set before queuing any chunk, otherwise an early finisher could think it was the last.
+		current.RemainingChunks = current.ChunkCount;
+
+		if (current.WorkSize == 0)
+		{
+			Pool.QueueJob([this, node]()
+			{
+				EntityCommandBuffer::Scope scope(Nodes[node].CommandBuffers[0]);
+				Nodes[node].System->Update(DeltaTime);
+				Complete(node);
+			}, &Group);
+			return;
+		}
+
+		for (size_t chunk = 0; chunk < current.ChunkCount; ++chunk)
+		{
+			Pool.QueueJob([this, node, chunk]()
+			{
+				Node& current = Nodes[node];
+				const size_t begin = chunk * current.ChunkSize;
+				const size_t end = std::min(begin + current.ChunkSize, current.WorkSize);
+
+				EntityCommandBuffer::Scope scope(current.CommandBuffers[chunk]);
+				current.System->UpdateRange(DeltaTime, begin, end);
+				Complete(node);
+			}, &Group);
+		}
+	}
+
+	void SystemScheduler::Complete(size_t node)
+	{
+		if (--Nodes[node].RemainingChunks > 0) { return; }
+
+		for (size_t dependent : Nodes[node].Dependents)
+		{
+			if (--Nodes[dependent].RemainingDependencies == 0) { Queue(dependent); }
+		}
+	}
+
+	void SystemScheduler::Run(const std::vector<std::unique_ptr<BaseSystem>>& systems, const float& deltaTime)
+	{
+		const bool isChanged = systems.size() != Nodes.size() ||
+			!std::equal(systems.begin(), systems.end(), Nodes.begin(),
+				[](const std::unique_ptr<BaseSystem>& system, const Node& node) { return system.get() == node.System; });
+		if (isChanged) { Build(systems); }
+
+		DeltaTime = deltaTime;
+
+		// Work sizes are found up front on this thread, as views can't change while systems are running.
+		for (Node& node : Nodes)
+		{
+			node.WorkSize = node.System->GetWorkSize();
+			node.RemainingDependencies = node.DependencyCount;
+
+			node.ChunkSize = node.WorkSize;
+			node.ChunkCount = 1;
+			if (node.WorkSize > 0)
+			{
+				const size_t maxChunks = (node.WorkSize + MINIMUM_CHUNK_SIZE - 1) / MINIMUM_CHUNK_SIZE;
+				const size_t chunks = std::clamp<size_t>(Pool.GetThreadCount(), 1, maxChunks);
+				node.ChunkSize = (node.WorkSize + chunks - 1) / chunks;
+				node.ChunkCount = (node.WorkSize + node.ChunkSize - 1) / node.ChunkSize;
+			}
+
+			if (node.CommandBuffers.size() < node.ChunkCount) { node.CommandBuffers.resize(node.ChunkCount); }
+		}
+
+		for (size_t i = 0; i < Nodes.size(); ++i)
+		{
+			if (Nodes[i].DependencyCount == 0) { Queue(i); }
+		}
+
+		Pool.Wait(Group);
+	}
+
+	void SystemScheduler::PlaybackCommands(EntityManager& entityManager)
+	{
+		// Chunks are in entity order, so this is the same order as if every system had run on one thread.
+		for (Node& node : Nodes)
+		{
+			for (size_t chunk = 0; chunk < node.ChunkCount; ++chunk)
+			{
+				node.CommandBuffers[chunk].Playback(entityManager);
+			}
+		}
+	}
+}
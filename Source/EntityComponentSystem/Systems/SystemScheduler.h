@@ -0,0 +1,62 @@
+#pragma once
+#include "BaseSystem.h"
+#include "../../Core/ThreadPool.h"
+#include "../EntityCommandBuffer.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Runs systems on a thread pool, in parallel where their declared component access doesn't conflict and in the
+	/// order they were added where it does. Systems with a work size are also split into chunks across threads.
+	/// </summary>
+	class SystemScheduler
+	{
+	private:
+		struct Node
+		{
+			BaseSystem* System = nullptr;
+			std::vector<size_t> Dependents; // Systems that can't start until this one has finished.
+			size_t DependencyCount = 0;
+
+			std::vector<EntityCommandBuffer> CommandBuffers; // One per chunk, kept between runs to reuse their memory.
+
+			// Reset every run.
+			size_t WorkSize = 0;
+			size_t ChunkSize = 0;
+			size_t ChunkCount = 1;
+			std::atomic<size_t> RemainingDependencies = 0;
+			std::atomic<size_t> RemainingChunks = 0;
+		};
+
+		ThreadPool& Pool;
+		std::vector<Node> Nodes;
+		TaskGroup Group;
+		float DeltaTime = 0;
+
+		void Build(const std::vector<std::unique_ptr<BaseSystem>>& systems);
+		void Queue(size_t node);
+		void Complete(size_t node);
+
+	public:
+		/// <summary>
+		/// Chunks smaller than this aren't worth the overhead of another job.
+		/// </summary>
+		static constexpr size_t MINIMUM_CHUNK_SIZE = 256;
+
+		SystemScheduler(ThreadPool& pool) : Pool(pool) {}
+
+		/// <summary>
+		/// Updates every system, blocking until they have all finished. The dependency graph is only built the first time,
+		/// or when the systems change.
+		/// </summary>
+		void Run(const std::vector<std::unique_ptr<BaseSystem>>& systems, const float& deltaTime);
+
+		/// <summary>
+		/// Make the structural changes systems recorded during the last <see cref="Run"/>, in system then chunk order.
+		/// </summary>
+		void PlaybackCommands(EntityManager& entityManager);
+	};
+}
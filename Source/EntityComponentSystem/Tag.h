@@ -0,0 +1,67 @@
+#pragma once
+#include "../Core/NameTable.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Engine
+{
+	/// <summary>
+	/// A compact ID for an interned tag string, see <see cref="TagTable"/>.
+	/// </summary>
+	using TagId = uint16_t;
+
+	/// <summary>
+	/// Tags used by the engine itself. These are interned first, in this order, so their IDs are known at compile time.
+	/// </summary>
+	inline constexpr std::array<std::string_view, 4> BuiltInTagNames = { "Camera", "Player", "TileSet", "TestNPC" };
+
+	consteval TagId GetBuiltInTag(std::string_view name)
+	{
+		for (size_t i = 0; i < BuiltInTagNames.size(); ++i)
+		{
+			if (BuiltInTagNames[i] == name) { return static_cast<TagId>(i); }
+		}
+		throw "Not a built in tag, add it to BuiltInTagNames."; // Fails compilation.
+	}
+
+	namespace Tags
+	{
+		inline constexpr TagId Camera = GetBuiltInTag("Camera");
+		inline constexpr TagId Player = GetBuiltInTag("Player");
+		inline constexpr TagId TileSet = GetBuiltInTag("TileSet");
+		inline constexpr TagId TestNPC = GetBuiltInTag("TestNPC");
+	}
+
+	/// <summary>
+	/// Interns tag strings so that each is stored once and entities only need to hold a <see cref="TagId"/>.
+	/// </summary>
+	class TagTable
+	{
+	private:
+		NameTable<TagId> Names;
+
+		TagTable()
+		{
+			for (std::string_view name : BuiltInTagNames) { Names.Intern(name); }
+		}
+
+	public:
+		static TagTable& Instance()
+		{
+			static TagTable table;
+			return table;
+		}
+
+		/// <returns>The ID of the tag, adding it if it hasn't been seen before. Only allocates for new tags.</returns>
+		TagId Intern(std::string_view name) { return Names.Intern(name); }
+
+		const std::string& GetName(TagId id) const { return Names.GetName(id); }
+
+		/// <summary>
+		/// The number of tags interned so far, IDs are always less than this.
+		/// </summary>
+		size_t size() const { return Names.size(); }
+	};
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Inputs at least this large are sorted across every core, below it the threads cost more than they save.
+	/// </summary>
+	inline constexpr size_t ParallelRadixSortThreshold = 1 << 16;
+
+	/// <summary>
+	/// Sort keys into ascending order with a least significant digit radix sort, a byte at a time. Linear in the number
+	/// of keys and stable, so anything packed into the low bits of a key breaks ties between the higher bits.
+	/// </summary>
+	/// <remarks>
+	/// Bytes that are the same in every key can't change the order, so they're skipped. Keys that only use a few of
+	/// their bytes, such as those with the same Z, take fewer passes.
+	/// </remarks>
+	/// <param name="buffer">Scratch space, resized to fit the keys. Keep between calls to avoid allocating.</param>
+	inline void RadixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& buffer)
+	{
+		const size_t count = keys.size();
+		if (count < 2) { return; }
+
+		uint64_t differingBits = 0;
+		for (uint64_t key : keys) { differingBits |= key ^ keys[0]; }
+		if (differingBits == 0) { return; }
+
+		buffer.resize(count);
+
+		// Each chunk is counted and scattered on its own, then chunks are written one after another per digit so the
+		// sort stays stable.
+		const size_t chunkCount = count >= ParallelRadixSortThreshold ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+		const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+		std::vector<std::array<size_t, 256>> offsets(chunkCount);
+		std::vector<size_t> chunks(chunkCount);
+		std::iota(chunks.begin(), chunks.end(), size_t(0));
+
+		auto forEachChunk = [&chunks](auto&& function)
+		{
+			if (chunks.size() == 1) { function(size_t(0)); }
+			else { std::for_each(std::execution::par, chunks.begin(), chunks.end(), function); }
+		};
+
+		uint64_t* source = keys.data();
+		uint64_t* destination = buffer.data();
+		for (int shift = 0; shift < 64; shift += 8)
+		{
+			if (((differingBits >> shift) & 0xFF) == 0) { continue; }
+
+			forEachChunk([&, shift](size_t chunk)
+			{
+				std::array<size_t, 256>& chunkOffsets = offsets[chunk];
+				chunkOffsets.fill(0);
+				const size_t end = std::min(count, (chunk + 1) * chunkSize);
+				for (size_t i = chunk * chunkSize; i < end; ++i) { ++chunkOffsets[(source[i] >> shift) & 0xFF]; }
+			});
+
+			size_t offset = 0;
+			for (size_t digit = 0; digit < 256; ++digit)
+			{
+				for (std::array<size_t, 256>& chunkOffsets : offsets)
+				{
+					const size_t digitCount = chunkOffsets[digit];
+					chunkOffsets[digit] = offset;
+					offset += digitCount;
+				}
+			}
+
+			forEachChunk([&, shift](size_t chunk)
+			{
+				std::array<size_t, 256>& chunkOffsets = offsets[chunk];
+				const size_t end = std::min(count, (chunk + 1) * chunkSize);
+				for (size_t i = chunk * chunkSize; i < end; ++i) { destination[chunkOffsets[(source[i] >> shift) & 0xFF]++] = source[i]; }
+			});
+
+			std::swap(source, destination);
+		}
+
+		if (source != keys.data()) { std::copy(source, source + count, keys.data()); }
+	}
+
+	inline void RadixSort(std::vector<uint64_t>& keys)
+	{
+		std::vector<uint64_t> buffer;
+		RadixSort(keys, buffer);
+	}
+}
@@ -0,0 +1,78 @@
+#include "FlowField.h"
+#include <array>
+
+namespace Engine
+{
+	std::optional<size_t> FlowField::GetIndex(Vector2<int> cell) const
+	{
+		const Vector2<int> local = cell - Origin;
+		if (local.X < 0 || local.Y < 0 || local.X >= Size.X || local.Y >= Size.Y) { return std::nullopt; }
+		return static_cast<size_t>(local.Y) * Size.X + local.X;
+	}
+
+	void FlowField::Build(const WalkabilityGrid& grid, Vector2<int> goal)
+	{
+		Goal = goal;
+		Origin = grid.GetOrigin();
+		Size = grid.GetSize();
+		Distances.assign(grid.GetCellCount(), Unreached);
+		Directions.assign(grid.GetCellCount(), NoDirection);
+		ReachedCount = 0;
+		if (!grid.Contains(goal)) { return; }
+
+		// Dijkstra out from the goal, following edges backwards, so a cell's distance is the cost of the cheapest way
+		// from it and the move it was last improved by is the way to go. No move costs more than the largest cost, so
+		// every distance still to explore is within that of the current one, and a ring of that many buckets can
+		// stand in for a priority queue.
+		thread_local std::array<std::vector<size_t>, std::numeric_limits<uint8_t>::max() + 1> buckets;
+		for (std::vector<size_t>& bucket : buckets) { bucket.clear(); }
+
+		const size_t goalIndex = grid.GetIndex(goal);
+		Distances[goalIndex] = 0;
+		buckets[0].push_back(goalIndex);
+		size_t queuedCount = 1;
+
+		for (int distance = 0; queuedCount > 0; ++distance)
+		{
+			std::vector<size_t>& bucket = buckets[distance % buckets.size()];
+			while (!bucket.empty())
+			{
+				const size_t current = bucket.back();
+				bucket.pop_back();
+				--queuedCount;
+				if (Distances[current] != distance) { continue; } // Superseded by a cheaper way.
+				++ReachedCount;
+
+				const Vector2<int> cell = grid.GetCell(current);
+				const int cost = distance + grid.GetCost(current);
+				for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
+				{
+					const Vector2<int> neighbour = cell - WalkabilityGrid::Directions[direction];
+					if (!grid.Contains(neighbour) || !grid.CanMove(neighbour, direction)) { continue; }
+
+					const size_t neighbourIndex = grid.GetIndex(neighbour);
+					if (Distances[neighbourIndex] <= cost) { continue; }
+
+					Distances[neighbourIndex] = cost;
+					Directions[neighbourIndex] = static_cast<uint8_t>(direction);
+					buckets[cost % buckets.size()].push_back(neighbourIndex);
+					++queuedCount;
+				}
+			}
+		}
+	}
+
+	std::optional<int> FlowField::GetDistance(Vector2<int> cell) const
+	{
+		const std::optional<size_t> index = GetIndex(cell);
+		if (!index || Distances[*index] == Unreached) { return std::nullopt; }
+		return Distances[*index];
+	}
+
+	std::optional<Vector2<int>> FlowField::GetNext(Vector2<int> cell) const
+	{
+		const std::optional<size_t> index = GetIndex(cell);
+		if (!index || Directions[*index] == NoDirection) { return std::nullopt; }
+		return cell + WalkabilityGrid::Directions[Directions[*index]];
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "WalkabilityGrid.h"
+#include "../Maths/Vector2.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// The way to one goal cell from every cell of a <see cref="WalkabilityGrid"/>, found with a single search out from
+	/// the goal that weighs each move by the cost of the cell moved into. Any number of agents heading to the same goal
+	/// can then look up their next step, rather than each searching for their own path.
+	/// </summary>
+	class FlowField
+	{
+		static constexpr uint8_t NoDirection = std::numeric_limits<uint8_t>::max();
+		static constexpr int Unreached = std::numeric_limits<int>::max();
+
+		Vector2<int> Goal;
+		Vector2<int> Origin; // Of the grid the field was built over.
+		Vector2<int> Size;
+		std::vector<int> Distances; // Integration field, the cost of the cheapest way from each cell to the goal.
+		std::vector<uint8_t> Directions; // Index into WalkabilityGrid::Directions of the move towards the goal.
+		size_t ReachedCount = 0;
+
+		/// <returns>The index of a cell in the field, or nothing if it's outside the grid.</returns>
+		std::optional<size_t> GetIndex(Vector2<int> cell) const;
+
+	public:
+		/// <summary>
+		/// Fill the field for the goal, from every cell the goal can be reached from.
+		/// </summary>
+		void Build(const WalkabilityGrid& grid, Vector2<int> goal);
+
+		Vector2<int> GetGoal() const { return Goal; }
+
+		/// <returns>How many cells the goal can be reached from, including itself, as of the last build.</returns>
+		size_t GetReachedCount() const { return ReachedCount; }
+
+		/// <returns>The cost of the cheapest way from a cell to the goal, or nothing if the goal can't be reached from it.</returns>
+		std::optional<int> GetDistance(Vector2<int> cell) const;
+
+		/// <returns>The neighbouring cell next along the cheapest way to the goal, or nothing if at the goal or it can't be reached.</returns>
+		std::optional<Vector2<int>> GetNext(Vector2<int> cell) const;
+	};
+}
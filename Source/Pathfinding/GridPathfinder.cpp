@@ -0,0 +1,295 @@
+#include "GridPathfinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <tuple>
+
+namespace Engine
+{
+	bool GridPathfinder::IsBefore(uint32_t a, uint32_t b) const
+	{
+		// Break ties towards the node furthest along, which is closer to the goal, to expand fewer nodes.
+		if (Nodes[a].Priority != Nodes[b].Priority) { return Nodes[a].Priority < Nodes[b].Priority; }
+		return Nodes[a].Cost > Nodes[b].Cost;
+	}
+
+	void GridPathfinder::SiftUp(uint32_t heapIndex)
+	{
+		const uint32_t node = Heap[heapIndex];
+		while (heapIndex > 0)
+		{
+			const uint32_t parentIndex = (heapIndex - 1) / 2;
+			if (!IsBefore(node, Heap[parentIndex])) { break; }
+
+			Heap[heapIndex] = Heap[parentIndex];
+			Nodes[Heap[heapIndex]].HeapIndex = heapIndex;
+			heapIndex = parentIndex;
+		}
+		Heap[heapIndex] = node;
+		Nodes[node].HeapIndex = heapIndex;
+	}
+
+	void GridPathfinder::SiftDown(uint32_t heapIndex)
+	{
+		const uint32_t node = Heap[heapIndex];
+		const uint32_t size = static_cast<uint32_t>(Heap.size());
+		while (true)
+		{
+			uint32_t childIndex = heapIndex * 2 + 1;
+			if (childIndex >= size) { break; }
+			if (childIndex + 1 < size && IsBefore(Heap[childIndex + 1], Heap[childIndex])) { ++childIndex; }
+			if (!IsBefore(Heap[childIndex], node)) { break; }
+
+			Heap[heapIndex] = Heap[childIndex];
+			Nodes[Heap[heapIndex]].HeapIndex = heapIndex;
+			heapIndex = childIndex;
+		}
+		Heap[heapIndex] = node;
+		Nodes[node].HeapIndex = heapIndex;
+	}
+
+	void GridPathfinder::Push(uint32_t node)
+	{
+		Heap.push_back(node);
+		SiftUp(static_cast<uint32_t>(Heap.size() - 1));
+	}
+
+	uint32_t GridPathfinder::Pop()
+	{
+		const uint32_t top = Heap.front();
+		Nodes[top].HeapIndex = NotInHeap;
+
+		const uint32_t last = Heap.back();
+		Heap.pop_back();
+		if (!Heap.empty())
+		{
+			Heap[0] = last;
+			SiftDown(0);
+		}
+
+		return top;
+	}
+
+	GridPathfinder::Node& GridPathfinder::Visit(uint32_t index)
+	{
+		Node& node = Nodes[index];
+		if (node.Generation != Generation) { node = { Generation, index, std::numeric_limits<int>::max(), 0, NotInHeap }; }
+		return node;
+	}
+
+	void GridPathfinder::Reset(const WalkabilityGrid& grid)
+	{
+		if (Nodes.size() < grid.GetCellCount()) { Nodes.resize(grid.GetCellCount()); }
+		Heap.clear();
+		ExpandedCount = 0;
+
+		// Once the generation wraps around old nodes could look current, so they do need clearing then.
+		if (++Generation == 0)
+		{
+			std::fill(Nodes.begin(), Nodes.end(), Node{});
+			Generation = 1;
+		}
+	}
+
+	void GridPathfinder::ConstructPath(const WalkabilityGrid& grid, uint32_t goal, std::vector<Vector2<int>>& path) const
+	{
+		uint32_t current = goal;
+		path.push_back(grid.GetCell(current));
+		while (Nodes[current].Parent != current)
+		{
+			current = Nodes[current].Parent;
+
+			const Vector2<int> parentCell = grid.GetCell(current);
+			Vector2<int> cell = path.back();
+			while (cell != parentCell)
+			{
+				cell += Vector2<int>{ (parentCell.X > cell.X) - (parentCell.X < cell.X), (parentCell.Y > cell.Y) - (parentCell.Y < cell.Y) };
+				path.push_back(cell);
+			}
+		}
+		std::reverse(path.begin(), path.end());
+	}
+
+	void GridPathfinder::Relax(uint32_t current, Vector2<int> neighbourCell, uint32_t neighbourIndex, int cost, Vector2<int> goal)
+	{
+		Node& neighbour = Visit(neighbourIndex);
+		if (cost >= neighbour.Cost) { return; } // Also skips expanded nodes, as the heuristic is consistent.
+
+		// Moving diagonally takes as many moves as moving straight, each costing at least the default, so the least the
+		// rest can cost is the larger axis difference times that.
+		neighbour.Cost = cost;
+		neighbour.Priority = cost + WalkabilityGrid::DefaultCost * std::max(std::abs(goal.X - neighbourCell.X), std::abs(goal.Y - neighbourCell.Y));
+		neighbour.Parent = current;
+		if (neighbour.HeapIndex == NotInHeap) { Push(neighbourIndex); }
+		else { SiftUp(neighbour.HeapIndex); } // Decrease key.
+	}
+
+	bool GridPathfinder::AStar(const WalkabilityGrid& grid, Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path)
+	{
+		path.clear();
+		if (!grid.Contains(start) || !grid.Contains(goal)) { return false; }
+
+		Reset(grid);
+
+		const uint32_t startIndex = static_cast<uint32_t>(grid.GetIndex(start));
+		const uint32_t goalIndex = static_cast<uint32_t>(grid.GetIndex(goal));
+		Relax(startIndex, start, startIndex, 0, goal);
+
+		while (!Heap.empty())
+		{
+			const uint32_t current = Pop();
+			if (current == goalIndex)
+			{
+				ConstructPath(grid, goalIndex, path);
+				return true;
+			}
+			++ExpandedCount;
+
+			const Vector2<int> cell = grid.GetCell(current);
+			const uint8_t walkable = grid.GetMask(current);
+			const int cost = Nodes[current].Cost;
+			for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
+			{
+				if (!(walkable & (1u << direction))) { continue; }
+
+				const Vector2<int> neighbourCell = cell + WalkabilityGrid::Directions[direction];
+				if (!grid.Contains(neighbourCell)) { continue; }
+
+				const uint32_t neighbourIndex = static_cast<uint32_t>(grid.GetIndex(neighbourCell));
+				Relax(current, neighbourCell, neighbourIndex, cost + grid.GetCost(neighbourIndex), goal);
+			}
+		}
+
+		return false;
+	}
+
+	bool GridPathfinder::IsOpen(const WalkabilityGrid& grid, Vector2<int> cell)
+	{
+		if (grid.GetMask(cell) != WalkabilityGrid::AllDirections) { return false; }
+		for (const Vector2<int>& direction : WalkabilityGrid::Directions)
+		{
+			if (grid.GetMask(cell + direction) != WalkabilityGrid::AllDirections) { return false; }
+		}
+		return true;
+	}
+
+	uint8_t GridPathfinder::GetForcedDirections(const WalkabilityGrid& grid, Vector2<int> cell, Vector2<int> direction)
+	{
+		if (IsOpen(grid, cell)) { return 0; }
+
+		const Vector2<int> previous = cell - direction;
+		auto isAdjacent = [](Vector2<int> a, Vector2<int> b) { return std::max(std::abs(a.X - b.X), std::abs(a.Y - b.Y)) == 1; };
+		auto isDiagonalMove = [](Vector2<int> move) { return move.X != 0 && move.Y != 0; };
+		auto canStep = [&grid](Vector2<int> from, Vector2<int> to)
+		{
+			return grid.Contains(to) && grid.CanMove(from, WalkabilityGrid::GetDirectionIndex(to - from));
+		};
+
+		// Routes with fewer diagonal moves come first, then those moving diagonally first, as in the usual pruning rules.
+		auto getOrder = [&isDiagonalMove](Vector2<int> first, Vector2<int> second)
+		{
+			return std::tuple{ isDiagonalMove(first) + isDiagonalMove(second), !isDiagonalMove(first), WalkabilityGrid::GetDirectionIndex(first) };
+		};
+
+		const bool isDiagonal = isDiagonalMove(direction);
+		uint8_t forced = 0;
+		for (size_t i = 0; i < WalkabilityGrid::Directions.size(); ++i)
+		{
+			const Vector2<int> offset = WalkabilityGrid::Directions[i];
+			const Vector2<int> neighbour = cell + offset;
+
+			// Natural neighbours are always searched, so never need forcing.
+			const bool isNatural = offset == direction || (isDiagonal && (offset == Vector2<int>{ direction.X, 0 } || offset == Vector2<int>{ 0, direction.Y }));
+			if (isNatural || neighbour == previous || !canStep(cell, neighbour)) { continue; }
+
+			// Going through this cell takes two moves, so look for a route that avoids it in one move, or in two moves
+			// that come first in a fixed order of two move routes. Ties have to be broken the same way from every cell,
+			// otherwise two cells could each leave the neighbour to the other and neither search it.
+			const auto order = getOrder(direction, offset);
+			bool isAvoidable = isAdjacent(previous, neighbour) && canStep(previous, neighbour);
+			for (size_t j = 0; j < WalkabilityGrid::Directions.size() && !isAvoidable; ++j)
+			{
+				const Vector2<int> between = previous + WalkabilityGrid::Directions[j];
+				if (between == cell || !isAdjacent(between, neighbour)) { continue; }
+
+				isAvoidable = getOrder(between - previous, neighbour - between) < order && canStep(previous, between) && canStep(between, neighbour);
+			}
+
+			if (!isAvoidable) { forced |= 1u << i; }
+		}
+
+		return forced;
+	}
+
+	std::optional<Vector2<int>> GridPathfinder::Jump(const WalkabilityGrid& grid, Vector2<int> cell, Vector2<int> direction, Vector2<int> goal)
+	{
+		const size_t directionIndex = WalkabilityGrid::GetDirectionIndex(direction);
+		const bool isDiagonal = direction.X != 0 && direction.Y != 0;
+
+		while (true)
+		{
+			if (!grid.CanMove(cell, directionIndex) || !grid.Contains(cell + direction)) { return std::nullopt; }
+			cell += direction;
+
+			if (cell == goal || GetForcedDirections(grid, cell, direction)) { return cell; }
+
+			// Diagonal jumps stop where either of their straight parts would find something.
+			if (isDiagonal && (Jump(grid, cell, { direction.X, 0 }, goal) || Jump(grid, cell, { 0, direction.Y }, goal))) { return cell; }
+		}
+	}
+
+	bool GridPathfinder::JumpPointSearch(const WalkabilityGrid& grid, Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path)
+	{
+		// Jumping over cells assumes they all cost the same to cross.
+		if (!grid.IsUniformCost()) { return AStar(grid, start, goal, path); }
+
+		path.clear();
+		if (!grid.Contains(start) || !grid.Contains(goal)) { return false; }
+
+		Reset(grid);
+
+		const uint32_t startIndex = static_cast<uint32_t>(grid.GetIndex(start));
+		const uint32_t goalIndex = static_cast<uint32_t>(grid.GetIndex(goal));
+		Relax(startIndex, start, startIndex, 0, goal);
+
+		while (!Heap.empty())
+		{
+			const uint32_t current = Pop();
+			if (current == goalIndex)
+			{
+				ConstructPath(grid, goalIndex, path);
+				return true;
+			}
+			++ExpandedCount;
+
+			const Vector2<int> cell = grid.GetCell(current);
+			const Vector2<int> parentCell = grid.GetCell(Nodes[current].Parent);
+			const Vector2<int> direction = { (cell.X > parentCell.X) - (cell.X < parentCell.X), (cell.Y > parentCell.Y) - (cell.Y < parentCell.Y) };
+
+			// Only the natural and forced neighbours need searching, any other neighbour can be reached at least as
+			// cheaply without going through this cell. The start has no direction so searches every neighbour.
+			uint8_t successors = WalkabilityGrid::AllDirections;
+			if (current != Nodes[current].Parent)
+			{
+				successors = GetForcedDirections(grid, cell, direction) | (1u << WalkabilityGrid::GetDirectionIndex(direction));
+				if (direction.X != 0 && direction.Y != 0)
+				{
+					successors |= 1u << WalkabilityGrid::GetDirectionIndex({ direction.X, 0 });
+					successors |= 1u << WalkabilityGrid::GetDirectionIndex({ 0, direction.Y });
+				}
+			}
+
+			for (size_t i = 0; i < WalkabilityGrid::Directions.size(); ++i)
+			{
+				if (!(successors & (1u << i))) { continue; }
+
+				const std::optional<Vector2<int>> jumpPoint = Jump(grid, cell, WalkabilityGrid::Directions[i], goal);
+				if (!jumpPoint) { continue; }
+
+				const int distance = std::max(std::abs(jumpPoint->X - cell.X), std::abs(jumpPoint->Y - cell.Y));
+				Relax(current, *jumpPoint, static_cast<uint32_t>(grid.GetIndex(*jumpPoint)), Nodes[current].Cost + distance, goal);
+			}
+		}
+
+		return false;
+	}
+}
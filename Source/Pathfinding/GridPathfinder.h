@@ -0,0 +1,119 @@
+#pragma once
+#include "WalkabilityGrid.h"
+#include "../Maths/Vector2.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Searches a <see cref="WalkabilityGrid"/> for paths, keeping its node storage between searches so that repeated
+	/// searches allocate nothing once it has grown to the size of the grid.
+	/// </summary>
+	/// <remarks>
+	/// Not thread safe, use one per thread.
+	/// </remarks>
+	class GridPathfinder
+	{
+		static constexpr uint32_t NotInHeap = std::numeric_limits<uint32_t>::max();
+
+		/// <summary>
+		/// Search state for a grid cell, indexed the same as the grid. Only valid when its generation matches the
+		/// current one, so starting a new search is a matter of bumping the generation rather than clearing every node.
+		/// </summary>
+		struct Node
+		{
+			uint32_t Generation = 0;
+			uint32_t Parent = 0;
+			int Cost = 0; // Cost so far from the start.
+			int Priority = 0; // Cost plus the heuristic estimate to the goal.
+			uint32_t HeapIndex = NotInHeap; // NotInHeap once expanded.
+		};
+
+		std::vector<Node> Nodes;
+		uint32_t Generation = 0;
+
+		/// <summary>
+		/// Binary min heap of node indices ordered by priority, with each node storing its position so that its
+		/// priority can be decreased in place.
+		/// </summary>
+		std::vector<uint32_t> Heap;
+
+		size_t ExpandedCount = 0;
+
+		bool IsBefore(uint32_t a, uint32_t b) const;
+		void SiftUp(uint32_t heapIndex);
+		void SiftDown(uint32_t heapIndex);
+		void Push(uint32_t node);
+		uint32_t Pop();
+
+		/// <summary>
+		/// Get a node ready for use in this search, resetting it if it was last touched by a previous one.
+		/// </summary>
+		Node& Visit(uint32_t index);
+		bool IsVisited(uint32_t index) const { return Nodes[index].Generation == Generation; }
+
+		/// <summary>
+		/// Start a new search over the grid, growing the node storage if it has grown.
+		/// </summary>
+		void Reset(const WalkabilityGrid& grid);
+
+		/// <summary>
+		/// Fill the path by following parents back from the goal, then reverse it. Parents more than a cell apart, as
+		/// found by jump point search, are joined by the straight or diagonal line between them.
+		/// </summary>
+		void ConstructPath(const WalkabilityGrid& grid, uint32_t goal, std::vector<Vector2<int>>& path) const;
+
+		/// <summary>
+		/// Add a neighbour to the open set if this is the cheapest way found to it so far.
+		/// </summary>
+		void Relax(uint32_t current, Vector2<int> neighbourCell, uint32_t neighbourIndex, int cost, Vector2<int> goal);
+
+		/// <returns>True if every edge around the cell and its neighbours is walkable, so it can't have forced neighbours.</returns>
+		static bool IsOpen(const WalkabilityGrid& grid, Vector2<int> cell);
+
+		/// <summary>
+		/// Find the neighbours of a cell, reached by moving in a direction, that can't be reached as cheaply from the
+		/// previous cell without going through it. Walkability is stored per edge rather than per cell, so rather
+		/// than the usual patterns of blocked cells this checks for each neighbour whether such a route exists.
+		/// </summary>
+		/// <returns>A mask of the directions to the forced neighbours, in the same order as <see cref="WalkabilityGrid::Directions"/>.</returns>
+		static uint8_t GetForcedDirections(const WalkabilityGrid& grid, Vector2<int> cell, Vector2<int> direction);
+
+		/// <summary>
+		/// Step from a cell in a direction until reaching the goal, a cell with forced neighbours or, for diagonals, a
+		/// cell from which a straight jump finds one of those.
+		/// </summary>
+		/// <returns>The jump point, or nothing if the way is blocked first.</returns>
+		static std::optional<Vector2<int>> Jump(const WalkabilityGrid& grid, Vector2<int> cell, Vector2<int> direction, Vector2<int> goal);
+
+	public:
+		/// <summary>
+		/// Find the cheapest path between two cells, moving in any of the eight directions at the cost of the cell
+		/// moved into.
+		/// </summary>
+		/// <param name="path">Cleared then filled with every cell along the path, start and goal included.</param>
+		/// <returns>False if there is no path, including when either cell is outside the grid.</returns>
+		bool AStar(const WalkabilityGrid& grid, Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path);
+
+		/// <summary>
+		/// Find the same cost path as <see cref="AStar"/> using jump point search, which skips over open areas of the
+		/// grid in straight lines instead of expanding every cell along them. Relies on every move costing the same, so
+		/// falls back to <see cref="AStar"/> when the grid has any weighted cells.
+		/// </summary>
+		/// <remarks>
+		/// Expands far fewer nodes than <see cref="AStar"/> but is slower on every map the pathfinding benchmarks
+		/// generate, as each diagonal step scans straight to the next wall or the edge of the grid, so a query touches
+		/// cells in proportion to the area of the grid. Precomputed jump distances (JPS+) would avoid the scans, until
+		/// then searches that matter should use <see cref="AStar"/>.
+		/// </remarks>
+		/// <param name="path">Cleared then filled with every cell along the path, start and goal included.</param>
+		/// <returns>False if there is no path, including when either cell is outside the grid.</returns>
+		bool JumpPointSearch(const WalkabilityGrid& grid, Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path);
+
+		/// <returns>How many nodes the last search expanded.</returns>
+		size_t GetExpandedCount() const { return ExpandedCount; }
+	};
+}
@@ -0,0 +1,358 @@
+#include "HierarchicalGraph.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace Engine
+{
+	namespace
+	{
+		int GetChebyshevDistance(Vector2<int> a, Vector2<int> b)
+		{
+			return std::max(std::abs(a.X - b.X), std::abs(a.Y - b.Y));
+		}
+	}
+
+	HierarchicalGraph::HierarchicalGraph(int clusterSize) : ClusterSize(clusterSize) {}
+
+	size_t HierarchicalGraph::GetClusterIndex(Vector2<int> cell) const
+	{
+		const Vector2<int> local = cell - Origin;
+		return static_cast<size_t>(local.Y / ClusterSize) * ClusterCounts.X + local.X / ClusterSize;
+	}
+
+	Vector2<int> HierarchicalGraph::GetClusterOrigin(size_t cluster) const
+	{
+		return Origin + Vector2<int>{ static_cast<int>(cluster % ClusterCounts.X), static_cast<int>(cluster / ClusterCounts.X) } * ClusterSize;
+	}
+
+	Vector2<int> HierarchicalGraph::GetClusterSize(size_t cluster) const
+	{
+		// Clusters along the far sides are cut short by the edge of the grid.
+		const Vector2<int> offset = GetClusterOrigin(cluster) - Origin;
+		return { std::min(ClusterSize, Size.X - offset.X), std::min(ClusterSize, Size.Y - offset.Y) };
+	}
+
+	size_t HierarchicalGraph::GetNodeCount() const
+	{
+		size_t count = 0;
+		for (const Cluster& cluster : Clusters) { count += cluster.Nodes.size(); }
+		return count;
+	}
+
+	void HierarchicalGraph::SearchCluster(const WalkabilityGrid& grid, size_t cluster, Vector2<int> from, bool isReversed,
+		std::vector<int>& distances, std::vector<uint32_t>* parents, std::vector<uint32_t>& queue) const
+	{
+		const Vector2<int> origin = GetClusterOrigin(cluster);
+		const Vector2<int> size = GetClusterSize(cluster);
+		auto getLocalIndex = [origin, size](Vector2<int> cell) { return static_cast<uint32_t>((cell.Y - origin.Y) * size.X + (cell.X - origin.X)); };
+
+		distances.assign(static_cast<size_t>(size.X) * size.Y, Unreached);
+		if (parents) { parents->resize(distances.size()); }
+		queue.clear();
+
+		const uint32_t first = getLocalIndex(from);
+		distances[first] = 0;
+		if (parents) { (*parents)[first] = first; }
+		queue.push_back(first);
+
+		for (size_t i = 0; i < queue.size(); ++i)
+		{
+			const uint32_t local = queue[i];
+			const Vector2<int> cell = origin + Vector2<int>{ static_cast<int>(local % size.X), static_cast<int>(local / size.X) };
+			for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
+			{
+				const Vector2<int> neighbour = isReversed ? cell - WalkabilityGrid::Directions[direction] : cell + WalkabilityGrid::Directions[direction];
+				if (neighbour.X < origin.X || neighbour.Y < origin.Y || neighbour.X >= origin.X + size.X || neighbour.Y >= origin.Y + size.Y) { continue; }
+				if (!grid.CanMove(isReversed ? neighbour : cell, direction)) { continue; }
+
+				const uint32_t neighbourLocal = getLocalIndex(neighbour);
+				if (distances[neighbourLocal] != Unreached) { continue; }
+
+				distances[neighbourLocal] = distances[local] + 1;
+				if (parents) { (*parents)[neighbourLocal] = local; }
+				queue.push_back(neighbourLocal);
+			}
+		}
+	}
+
+	void HierarchicalGraph::AddNode(const WalkabilityGrid& grid, size_t cluster, Vector2<int> cell)
+	{
+		const uint32_t index = static_cast<uint32_t>(grid.GetIndex(cell));
+		if (NodeAt[index] != NoNode) { return; } // Corners can be on two sides.
+
+		std::vector<Node>& nodes = Clusters[cluster].Nodes;
+		NodeAt[index] = static_cast<uint32_t>(nodes.size());
+		nodes.push_back({ index, {} });
+	}
+
+	bool HierarchicalGraph::IsCrossable(const WalkabilityGrid& grid, Vector2<int> inside, Vector2<int> outside)
+	{
+		const Vector2<int> direction = outside - inside;
+		return grid.Contains(outside) && (grid.CanMove(inside, WalkabilityGrid::GetDirectionIndex(direction)) || grid.CanMove(outside, WalkabilityGrid::GetDirectionIndex(-direction)));
+	}
+
+	bool HierarchicalGraph::IsConnected(const WalkabilityGrid& grid, Vector2<int> cell, Vector2<int> next)
+	{
+		const Vector2<int> direction = next - cell;
+		return grid.CanMove(cell, WalkabilityGrid::GetDirectionIndex(direction)) && grid.CanMove(next, WalkabilityGrid::GetDirectionIndex(-direction));
+	}
+
+	bool HierarchicalGraph::IsSameEntrance(const WalkabilityGrid& grid, Vector2<int> inside, Vector2<int> step, Vector2<int> outwards)
+	{
+		const Vector2<int> nextInside = inside + step;
+		return IsCrossable(grid, inside, inside + outwards) && IsCrossable(grid, nextInside, nextInside + outwards)
+			&& IsConnected(grid, inside, nextInside) && IsConnected(grid, inside + outwards, nextInside + outwards);
+	}
+
+	void HierarchicalGraph::AddEntrances(const WalkabilityGrid& grid, size_t cluster, Vector2<int> first, Vector2<int> step, Vector2<int> outwards, int length)
+	{
+		// An entrance is a run of cells that can be crossed straight into the neighbouring cluster, or back from it,
+		// and that are connected to each other along both sides so that any of them can reach the entrance's nodes.
+		int runStart = -1;
+		for (int i = 0; i <= length; ++i)
+		{
+			const bool isCrossable = i < length && IsCrossable(grid, first + step * i, first + step * i + outwards);
+			const bool isContinued = isCrossable && runStart >= 0 && IsSameEntrance(grid, first + step * (i - 1), step, outwards);
+			if (runStart >= 0 && !isContinued)
+			{
+				const int runLength = i - runStart;
+				if (runLength >= WideEntranceLength)
+				{
+					AddNode(grid, cluster, first + step * runStart);
+					AddNode(grid, cluster, first + step * (i - 1));
+				}
+				else { AddNode(grid, cluster, first + step * (runStart + (runLength - 1) / 2)); }
+				runStart = -1;
+			}
+			if (isCrossable && runStart < 0) { runStart = i; }
+		}
+
+		// Diagonal crossings between different entrances, or where there are none, have a node at each end.
+		for (int i = 0; i + 1 < length; ++i)
+		{
+			const Vector2<int> inside = first + step * i;
+			const Vector2<int> nextInside = inside + step;
+			if (IsSameEntrance(grid, inside, step, outwards)) { continue; }
+
+			if (IsCrossable(grid, inside, nextInside + outwards)) { AddNode(grid, cluster, inside); }
+			if (IsCrossable(grid, nextInside, inside + outwards)) { AddNode(grid, cluster, nextInside); }
+		}
+	}
+
+	void HierarchicalGraph::RebuildCluster(const WalkabilityGrid& grid, size_t cluster)
+	{
+		std::vector<Node>& nodes = Clusters[cluster].Nodes;
+		for (const Node& node : nodes) { NodeAt[node.Cell] = NoNode; }
+		nodes.clear();
+		Clusters[cluster].IsDirty = false;
+
+		const Vector2<int> origin = GetClusterOrigin(cluster);
+		const Vector2<int> size = GetClusterSize(cluster);
+		const Vector2<int> last = origin + size - 1;
+		AddEntrances(grid, cluster, origin, { 1, 0 }, { 0, -1 }, size.X);
+		AddEntrances(grid, cluster, { origin.X, last.Y }, { 1, 0 }, { 0, 1 }, size.X);
+		AddEntrances(grid, cluster, origin, { 0, 1 }, { -1, 0 }, size.Y);
+		AddEntrances(grid, cluster, { last.X, origin.Y }, { 0, 1 }, { 1, 0 }, size.Y);
+
+		// Corners can be crossed diagonally into the clusters that only touch at the corner.
+		for (const Vector2<int> corner : { origin, Vector2<int>{ last.X, origin.Y }, Vector2<int>{ origin.X, last.Y }, last })
+		{
+			const Vector2<int> outwards = { corner.X == origin.X ? -1 : 1, corner.Y == origin.Y ? -1 : 1 };
+			if (IsCrossable(grid, corner, corner + outwards)) { AddNode(grid, cluster, corner); }
+		}
+
+		// Connect every pair of entrances with a path between them inside the cluster.
+		std::vector<int> distances;
+		std::vector<uint32_t> queue;
+		for (Node& node : nodes)
+		{
+			SearchCluster(grid, cluster, grid.GetCell(node.Cell), false, distances, nullptr, queue);
+			for (const Node& other : nodes)
+			{
+				const Vector2<int> otherCell = grid.GetCell(other.Cell) - origin;
+				const int distance = distances[otherCell.Y * size.X + otherCell.X];
+				if (other.Cell != node.Cell && distance != Unreached) { node.Edges.push_back({ other.Cell, distance }); }
+			}
+		}
+
+		++RebuiltCount;
+	}
+
+	void HierarchicalGraph::MarkDirty(size_t cluster)
+	{
+		if (Clusters[cluster].IsDirty) { return; }
+
+		Clusters[cluster].IsDirty = true;
+		DirtyClusters.push_back(cluster);
+	}
+
+	void HierarchicalGraph::Build(const WalkabilityGrid& grid)
+	{
+		Origin = grid.GetOrigin();
+		Size = grid.GetSize();
+		ClusterCounts = { (Size.X + ClusterSize - 1) / ClusterSize, (Size.Y + ClusterSize - 1) / ClusterSize };
+		Clusters.assign(static_cast<size_t>(ClusterCounts.X) * ClusterCounts.Y, {});
+		NodeAt.assign(grid.GetCellCount(), NoNode);
+		DirtyClusters.clear();
+
+		RebuiltCount = 0;
+		for (size_t cluster = 0; cluster < Clusters.size(); ++cluster) { RebuildCluster(grid, cluster); }
+	}
+
+	void HierarchicalGraph::MarkChanged(Vector2<int> cell)
+	{
+		const Vector2<int> local = cell - Origin;
+		if (Clusters.empty() || local.X < 0 || local.Y < 0 || local.X >= Size.X || local.Y >= Size.Y) { return; }
+
+		const size_t cluster = GetClusterIndex(cell);
+		MarkDirty(cluster);
+
+		const Vector2<int> clusterCoordinates = local / ClusterSize;
+		const Vector2<int> offset = local - clusterCoordinates * ClusterSize;
+		if (offset.X == 0 && clusterCoordinates.X > 0) { MarkDirty(cluster - 1); }
+		if (offset.X == ClusterSize - 1 && clusterCoordinates.X + 1 < ClusterCounts.X) { MarkDirty(cluster + 1); }
+		if (offset.Y == 0 && clusterCoordinates.Y > 0) { MarkDirty(cluster - ClusterCounts.X); }
+		if (offset.Y == ClusterSize - 1 && clusterCoordinates.Y + 1 < ClusterCounts.Y) { MarkDirty(cluster + ClusterCounts.X); }
+
+		// Corners also affect the clusters diagonally across from them.
+		const bool isHorizontalSide = offset.X == 0 || offset.X == ClusterSize - 1;
+		const bool isVerticalSide = offset.Y == 0 || offset.Y == ClusterSize - 1;
+		if (isHorizontalSide && isVerticalSide)
+		{
+			const Vector2<int> across = clusterCoordinates + Vector2<int>{ offset.X == 0 ? -1 : 1, offset.Y == 0 ? -1 : 1 };
+			if (across.X >= 0 && across.Y >= 0 && across.X < ClusterCounts.X && across.Y < ClusterCounts.Y)
+			{
+				MarkDirty(static_cast<size_t>(across.Y) * ClusterCounts.X + across.X);
+			}
+		}
+	}
+
+	void HierarchicalGraph::Update(const WalkabilityGrid& grid)
+	{
+		RebuiltCount = 0;
+		for (size_t cluster : DirtyClusters) { RebuildCluster(grid, cluster); }
+		DirtyClusters.clear();
+	}
+
+	bool HierarchicalGraph::FindPath(const WalkabilityGrid& grid, Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path) const
+	{
+		path.clear();
+		if (Clusters.empty() || !grid.Contains(start) || !grid.Contains(goal)) { return false; }
+
+		thread_local SearchState threadState;
+		SearchState& state = threadState;
+		const size_t cellCount = grid.GetCellCount();
+		if (state.Generations.size() < cellCount + 1)
+		{
+			state.Generations.resize(cellCount + 1, 0);
+			state.Costs.resize(cellCount + 1);
+			state.Parents.resize(cellCount + 1);
+		}
+		if (++state.Generation == 0)
+		{
+			std::fill(state.Generations.begin(), state.Generations.end(), 0);
+			state.Generation = 1;
+		}
+		state.Open.clear();
+
+		// How far the start is from each cell of its cluster, and how far each cell of the goal's cluster is from it.
+		const size_t startCluster = GetClusterIndex(start);
+		const size_t goalCluster = GetClusterIndex(goal);
+		const Vector2<int> startOrigin = GetClusterOrigin(startCluster);
+		const Vector2<int> goalOrigin = GetClusterOrigin(goalCluster);
+		const int startWidth = GetClusterSize(startCluster).X;
+		const int goalWidth = GetClusterSize(goalCluster).X;
+		SearchCluster(grid, startCluster, start, false, state.StartDistances, &state.StartParents, state.Queue);
+		SearchCluster(grid, goalCluster, goal, true, state.GoalDistances, nullptr, state.Queue);
+
+		// Search over grid indices, with one past the last standing for the goal so that it can be reached from any
+		// entrance of its cluster.
+		const uint32_t goalNode = static_cast<uint32_t>(cellCount);
+		auto getHeuristic = [goal, goalNode](uint32_t node, Vector2<int> cell) { return node == goalNode ? 0 : GetChebyshevDistance(cell, goal); };
+		auto relax = [&state, &getHeuristic](uint32_t node, Vector2<int> cell, uint32_t parent, int cost)
+		{
+			if (state.Generations[node] == state.Generation && cost >= state.Costs[node]) { return; }
+
+			state.Generations[node] = state.Generation;
+			state.Costs[node] = cost;
+			state.Parents[node] = parent;
+			state.Open.push_back({ cost + getHeuristic(node, cell), node });
+			std::push_heap(state.Open.begin(), state.Open.end(), std::greater<>{});
+		};
+
+		if (startCluster == goalCluster)
+		{
+			const Vector2<int> local = goal - startOrigin;
+			const int distance = state.StartDistances[local.Y * startWidth + local.X];
+			if (distance != Unreached) { relax(goalNode, goal, NoNode, distance); }
+		}
+
+		for (const Node& node : Clusters[startCluster].Nodes)
+		{
+			const Vector2<int> cell = grid.GetCell(node.Cell);
+			const Vector2<int> local = cell - startOrigin;
+			const int distance = state.StartDistances[local.Y * startWidth + local.X];
+			if (distance != Unreached) { relax(node.Cell, cell, node.Cell, distance); }
+		}
+
+		while (!state.Open.empty())
+		{
+			std::pop_heap(state.Open.begin(), state.Open.end(), std::greater<>{});
+			const auto [priority, current] = state.Open.back();
+			state.Open.pop_back();
+
+			if (current == goalNode) { break; }
+
+			const Vector2<int> cell = grid.GetCell(current);
+			const int cost = state.Costs[current];
+			if (priority != cost + getHeuristic(current, cell)) { continue; } // Superseded by a cheaper route.
+
+			const size_t cluster = GetClusterIndex(cell);
+			if (cluster == goalCluster)
+			{
+				const Vector2<int> local = cell - goalOrigin;
+				const int distance = state.GoalDistances[local.Y * goalWidth + local.X];
+				if (distance != Unreached) { relax(goalNode, goal, current, cost + distance); }
+			}
+
+			for (const Edge& edge : Clusters[cluster].Nodes[NodeAt[current]].Edges)
+			{
+				relax(edge.Cell, grid.GetCell(edge.Cell), current, cost + edge.Cost);
+			}
+
+			// Entrances are crossed into the entrance on the other side.
+			const uint8_t walkable = grid.GetMask(current);
+			for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
+			{
+				const Vector2<int> neighbour = cell + WalkabilityGrid::Directions[direction];
+				if (!(walkable & (1u << direction)) || !grid.Contains(neighbour) || GetClusterIndex(neighbour) == cluster) { continue; }
+
+				const uint32_t neighbourIndex = static_cast<uint32_t>(grid.GetIndex(neighbour));
+				if (NodeAt[neighbourIndex] != NoNode) { relax(neighbourIndex, neighbour, current, cost + 1); }
+			}
+		}
+
+		if (state.Generations[goalNode] != state.Generation) { return false; }
+
+		// Follow the entrances back from the goal, built in reverse.
+		path.push_back(goal);
+		for (uint32_t node = state.Parents[goalNode]; node != NoNode; node = state.Parents[node])
+		{
+			const Vector2<int> cell = grid.GetCell(node);
+			if (cell != path.back()) { path.push_back(cell); }
+			if (state.Parents[node] == node) { break; }
+		}
+
+		// Then refine the way from the start to the first entrance, which the start's search already found.
+		const Vector2<int> firstLocal = path.back() - startOrigin;
+		for (uint32_t local = firstLocal.Y * startWidth + firstLocal.X; state.StartParents[local] != local;)
+		{
+			local = state.StartParents[local];
+			path.push_back(startOrigin + Vector2<int>{ static_cast<int>(local % startWidth), static_cast<int>(local / startWidth) });
+		}
+
+		std::reverse(path.begin(), path.end());
+		return true;
+	}
+}
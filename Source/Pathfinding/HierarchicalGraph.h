@@ -0,0 +1,152 @@
+#pragma once
+#include "WalkabilityGrid.h"
+#include "../Maths/Vector2.h"
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// A coarse graph over a <see cref="WalkabilityGrid"/> for hierarchical pathfinding (HPA*). The grid is split into
+	/// square clusters, with nodes at the entrances between neighbouring clusters and edges between the entrances of a
+	/// cluster costing the length of the path between them. Searches run over the entrances rather than every cell,
+	/// so their cost depends on the number of clusters crossed rather than the size of the map.
+	/// </summary>
+	/// <remarks>
+	/// Paths are close to, but not always, the cheapest possible. Searches are thread safe, building is not.
+	/// </remarks>
+	class HierarchicalGraph
+	{
+		static constexpr uint32_t NoNode = std::numeric_limits<uint32_t>::max();
+		static constexpr int Unreached = std::numeric_limits<int>::max();
+
+		/// <summary>
+		/// Entrances at least this wide get a node at each end rather than one in the middle, so that paths don't
+		/// have to detour through the middle of a long opening.
+		/// </summary>
+		static constexpr int WideEntranceLength = 6;
+
+		struct Edge
+		{
+			uint32_t Cell; // Grid index of the entrance at the other end.
+			int Cost;
+		};
+
+		struct Node
+		{
+			uint32_t Cell; // Grid index of the cell the entrance is at.
+			std::vector<Edge> Edges; // To the other entrances of the same cluster.
+		};
+
+		struct Cluster
+		{
+			std::vector<Node> Nodes;
+			bool IsDirty = false;
+		};
+
+		int ClusterSize;
+		Vector2<int> Origin;
+		Vector2<int> Size;
+		Vector2<int> ClusterCounts;
+		std::vector<Cluster> Clusters;
+		std::vector<uint32_t> NodeAt; // Per grid cell, its node's index within its cluster, or NoNode.
+		std::vector<size_t> DirtyClusters;
+		size_t RebuiltCount = 0;
+
+		/// <summary>
+		/// Search state kept per thread, so searches can run in parallel without allocating.
+		/// </summary>
+		struct SearchState
+		{
+			std::vector<uint32_t> Generations;
+			std::vector<int> Costs;
+			std::vector<uint32_t> Parents;
+			uint32_t Generation = 0;
+			std::vector<std::pair<int, uint32_t>> Open; // Heap of priority and grid index, stale entries are skipped.
+
+			std::vector<int> StartDistances;
+			std::vector<uint32_t> StartParents;
+			std::vector<int> GoalDistances;
+			std::vector<uint32_t> Queue;
+		};
+
+		size_t GetClusterIndex(Vector2<int> cell) const;
+		Vector2<int> GetClusterOrigin(size_t cluster) const;
+		Vector2<int> GetClusterSize(size_t cluster) const;
+
+		/// <summary>
+		/// Breadth first search from a cell without leaving its cluster. Every move costs the same, so this gives the
+		/// cheapest distance to every cell in the cluster.
+		/// </summary>
+		/// <param name="isReversed">Follow edges backwards, giving the distance from every cell to this one instead.</param>
+		/// <param name="distances">Filled with the distance for each cell, indexed row by row within the cluster.</param>
+		/// <param name="parents">If given, filled with the cell each cell was reached from, in the same indexing.</param>
+		void SearchCluster(const WalkabilityGrid& grid, size_t cluster, Vector2<int> from, bool isReversed,
+			std::vector<int>& distances, std::vector<uint32_t>* parents, std::vector<uint32_t>& queue) const;
+
+		void AddNode(const WalkabilityGrid& grid, size_t cluster, Vector2<int> cell);
+
+		/// <returns>True if either cell can be moved to directly from the other.</returns>
+		static bool IsCrossable(const WalkabilityGrid& grid, Vector2<int> inside, Vector2<int> outside);
+
+		/// <returns>True if each cell can be moved to directly from the other.</returns>
+		static bool IsConnected(const WalkabilityGrid& grid, Vector2<int> cell, Vector2<int> next);
+
+		/// <returns>
+		/// True if a cell along a side and the next one are both crossable, and connected to each other on both sides,
+		/// so belong to the same entrance.
+		/// </returns>
+		static bool IsSameEntrance(const WalkabilityGrid& grid, Vector2<int> inside, Vector2<int> step, Vector2<int> outwards);
+
+		/// <summary>
+		/// Add nodes for the entrances along one side of a cluster. Both clusters sharing a side find the same
+		/// entrances, so the nodes on either side always line up.
+		/// </summary>
+		void AddEntrances(const WalkabilityGrid& grid, size_t cluster, Vector2<int> first, Vector2<int> step, Vector2<int> outwards, int length);
+
+		/// <summary>
+		/// Replace a cluster's nodes and the edges between them.
+		/// </summary>
+		void RebuildCluster(const WalkabilityGrid& grid, size_t cluster);
+
+		void MarkDirty(size_t cluster);
+
+	public:
+		explicit HierarchicalGraph(int clusterSize = 16);
+
+		/// <summary>
+		/// Build the graph from scratch for the whole grid, which must be rebuilt if the grid is resized.
+		/// </summary>
+		void Build(const WalkabilityGrid& grid);
+
+		/// <summary>
+		/// Note that a cell's walkability has changed, so its cluster needs rebuilding. Cells along the side of a
+		/// cluster also affect the entrances, and so the cluster, on the other side.
+		/// </summary>
+		void MarkChanged(Vector2<int> cell);
+
+		/// <summary>
+		/// Rebuild only the clusters with changed cells since the last update.
+		/// </summary>
+		void Update(const WalkabilityGrid& grid);
+
+		/// <summary>
+		/// Find a path through the entrances between clusters. Only the part of the path within the starting cluster
+		/// is refined into cells, which is all an agent needs before searching again from further along.
+		/// </summary>
+		/// <param name="grid">The grid the graph was built from.</param>
+		/// <param name="path">Cleared then filled with every cell up to the first entrance left through, followed by
+		/// the remaining entrances and the goal. Consecutive entries after the first entrance can be far apart.</param>
+		/// <returns>False if there is no path, including when either cell is outside the grid.</returns>
+		bool FindPath(const WalkabilityGrid& grid, Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path) const;
+
+		int GetClusterSize() const { return ClusterSize; }
+		size_t GetClusterCount() const { return Clusters.size(); }
+		size_t GetNodeCount() const;
+
+		/// <returns>How many clusters the last build or update rebuilt.</returns>
+		size_t GetRebuiltCount() const { return RebuiltCount; }
+	};
+}
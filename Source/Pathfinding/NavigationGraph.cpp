@@ -1,39 +1,67 @@
 #include "NavigationGraph.h"
+#include "GridPathfinder.h"
 #include "../Maths/Vector2.h"
 #include "../Collision/Intersections.h"
 #include "../SceneManagement/IsometricScene.h"
+#include "../EntityComponentSystem/EntityManager.h"
 #include <vector>
 #include <array>
 #include <algorithm>
 #include <queue>
+#include <cmath>
 
 namespace Engine
 {
-	using PriorityNode = std::pair<int, Vector2<int>>; // If the first elements are equal then the second element will be compared, making it more performant for priority to be first.
-
 	NavigationGraph::NavigationGraph(IsometricScene& scene) : Scene(scene) {}
 
-	std::vector<Vector2<int>> NavigationGraph::GetNeighbours(Vector2<int> centralNode) const // TODO: Make lambda and pass in via constructor? That way individual scenes could handle this function and it would avoid inheritence.
+	Vector2<int> NavigationGraph::GetNode(Vector2<int> cell) const
+	{
+		return static_cast<Vector2<int>>(Scene.GridToWorldSpace(static_cast<Vector2<float>>(cell))) + Vector2<int>{ 0, Scene.TileSize.Y / 4 };
+	}
+
+	Vector2<int> NavigationGraph::GetCell(Vector2<int> node) const
+	{
+		return static_cast<Vector2<int>>(Scene.WorldSpaceToGrid(static_cast<Vector2<float>>(node)));
+	}
+
+	float NavigationGraph::GetColliderReach() const
+	{
+		// The length between adjacent nodes using the world 0 as basis, with a little buffer to account for corners of a
+		// grid cell and positions being truncated.
+		return Scene.GridToWorldSpace({ 0, 2 }).Length() + 2;
+	}
+
+	std::vector<Vector2<int>> NavigationGraph::GetNeighbours(Vector2<int> centralNode) const
 	{
-		// Early exit to prevent never ending search. TODO: Probably better way to handle this.
-		if (centralNode.Length() > 1000) { return {}; }
+		const uint8_t walkable = Walkability.GetMask(GetCell(centralNode));
 
-		// Start by getting the adjacent nodes to the passed node.
-		std::vector adjacentNodes = Directions;
-		for (auto& position : adjacentNodes)
+		std::vector<Vector2<int>> adjacentNodes;
+		adjacentNodes.reserve(WalkabilityGrid::Directions.size());
+		for (size_t i = 0; i < WalkabilityGrid::Directions.size(); ++i)
 		{
-			position = (Vector2<int>)Scene.GridToWorldSpace((Vector2<float>)position) + centralNode;
+			if (walkable & (1u << i))
+			{
+				adjacentNodes.push_back((Vector2<int>)Scene.GridToWorldSpace((Vector2<float>)WalkabilityGrid::Directions[i]) + centralNode);
+			}
 		}
 
-		// Get the length between adjacent nodes by using the world 0 as basis with a little buffer to account for corners of a grid cell.
+		return adjacentNodes;
+	}
+
+	uint8_t NavigationGraph::BakeCell(Vector2<int> cell) const
+	{
+		const Vector2<int> centralNode = GetNode(cell);
+		if (centralNode.Length() > MAX_SEARCH_DISTANCE) { return 0; }
+
 		const int maxNodeDistanceSquared = Scene.GridToWorldSpace({ 0, 2 }).LengthSquared();
 
-		// Remove inaccessible nodes.
-		for (auto& entity : Scene.GetEntityManager().GetEntities())
+		uint8_t walkable = WalkabilityGrid::AllDirections;
+		for (Entity entity : Scene.ManagedSpatialHash.QueryRadius(static_cast<Vector2<float>>(centralNode), GetColliderReach()))
 		{
-			if (!entity.HasComponents<Position, Collider, Sprite>()) { continue; } // Entities with a collider should have a position, but best check anyway.
-			const Position& position = entity.GetComponent<Position>();
-			const Collider& collider = entity.GetComponent<Collider>();
+			if (!entity.IsAlive() || !entity.HasComponents<Collider, Sprite>()) { continue; }
+
+			const Position& position = entity.ReadComponent<Position>();
+			const Collider& collider = entity.ReadComponent<Collider>();
 
 			// If not an adjacent node skip.
 			const int distanceFromCentralNode = (centralNode - static_cast<Vector2<int>>(Vector2{ position.X, position.Y })).LengthSquared();
@@ -44,34 +72,191 @@ namespace Engine
 			for (auto& edge : collisionNodes)
 			{
 				edge += position;
-				edge -= entity.GetComponent<Sprite>().PivotOffset;
+				edge -= entity.ReadComponent<Sprite>().PivotOffset;
 			}
 
 			// For each adjacent node see if the connection intersects the entity's colliders.
-			std::erase_if(adjacentNodes, [centralNode, &collisionNodes](const Vector2<int> adjacentNode)
+			for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
 			{
+				if (!(walkable & (1u << direction))) { continue; }
+
+				const Vector2<int> adjacentNode = GetNode(cell + WalkabilityGrid::Directions[direction]);
 				const Edge<float> pathEdge = { static_cast<Vector2<float>>(adjacentNode), static_cast<Vector2<float>>(centralNode) };
 				for (size_t i = 1; i < collisionNodes.size(); ++i)
 				{
 					const Edge<float> collisionEdge = { collisionNodes[i - 1], collisionNodes[i] };
 					if (Collision::LineSegmentIntersection(pathEdge, collisionEdge))
 					{
-						return true;
+						walkable &= ~(1u << direction);
+						break;
 					}
 				}
+			}
+
+			if (!walkable) { break; } // Early exit if every direction is blocked.
+		}
+
+		return walkable;
+	}
 
-				return false;
-			});
+	void NavigationGraph::Bake(EntityManager& entityManager)
+	{
+		// Cover every cell whose node could be within the search distance.
+		const float tileWidth = static_cast<float>(Scene.TileSize.X);
+		const float tileHeight = Scene.TileSize.Y / 2.f;
+		const int extent = static_cast<int>(std::ceil(MAX_SEARCH_DISTANCE / tileWidth + MAX_SEARCH_DISTANCE / tileHeight)) + 1;
+		Walkability.Resize({ -extent, -extent }, { extent * 2 + 1, extent * 2 + 1 });
 
-			if (adjacentNodes.empty()) { return adjacentNodes; } // Early exit if all nodes have been erased.
+		for (size_t i = 0; i < Walkability.GetCellCount(); ++i)
+		{
+			const Vector2<int> cell = Walkability.GetCell(i);
+			Walkability.SetMask(cell, BakeCell(cell));
 		}
+		++Version;
 
-		return adjacentNodes;
+		BakedColliders.clear();
+		for (Entity entity : entityManager.GetView<Position, Collider, Sprite>())
+		{
+			const Position& position = entity.ReadComponent<Position>();
+			BakedColliders.insert_or_assign(entity.GetID(), BakedCollider{ entity, { position.X, position.Y } });
+		}
+
+		BakedTerrains.clear();
+		for (Entity entity : entityManager.GetView<Position, TerrainCost>())
+		{
+			BakeTerrain(entity);
+		}
+
+		BakedTileSize = Scene.TileSize;
+	}
+
+	void NavigationGraph::RebakeAround(Vector2<float> position)
+	{
+		// Rebake every cell in the bounding box of the cells the collider can reach, BakeCell does the precise check.
+		const float reach = GetColliderReach();
+		const std::array<Vector2<int>, 4> corners =
+		{
+			static_cast<Vector2<int>>(Scene.WorldSpaceToGrid(position + Vector2<float>{ -reach, -reach })),
+			static_cast<Vector2<int>>(Scene.WorldSpaceToGrid(position + Vector2<float>{ reach, -reach })),
+			static_cast<Vector2<int>>(Scene.WorldSpaceToGrid(position + Vector2<float>{ -reach, reach })),
+			static_cast<Vector2<int>>(Scene.WorldSpaceToGrid(position + Vector2<float>{ reach, reach }))
+		};
+
+		Vector2<int> first = corners[0];
+		Vector2<int> last = corners[0];
+		for (const Vector2<int>& corner : corners)
+		{
+			first = { std::min(first.X, corner.X), std::min(first.Y, corner.Y) };
+			last = { std::max(last.X, corner.X), std::max(last.Y, corner.Y) };
+		}
+
+		for (int x = first.X - 1; x <= last.X + 1; ++x)
+		{
+			for (int y = first.Y - 1; y <= last.Y + 1; ++y)
+			{
+				if (!Walkability.Contains({ x, y })) { continue; }
+
+				const uint8_t walkable = BakeCell({ x, y });
+				if (walkable == Walkability.GetMask({ x, y })) { continue; }
+
+				Walkability.SetMask({ x, y }, walkable);
+				++Version;
+			}
+		}
+	}
+
+	Vector2<int> NavigationGraph::GetTerrainCell(const Position& position) const
+	{
+		return GetCell(static_cast<Vector2<int>>(Vector2<float>{ position.X, position.Y }) + Vector2<int>{ 0, Scene.TileSize.Y / 4 });
+	}
+
+	void NavigationGraph::BakeTerrain(Entity entity)
+	{
+		const Vector2<int> cell = GetTerrainCell(entity.ReadComponent<Position>());
+		auto [baked, isAdded] = BakedTerrains.try_emplace(entity.GetID(), BakedTerrain{ entity, cell });
+		if (!isAdded)
+		{
+			if (baked->second.Owner == entity && baked->second.Cell != cell) { SetCost(baked->second.Cell, WalkabilityGrid::DefaultCost); }
+			baked->second = { entity, cell };
+		}
+
+		const int cost = std::clamp(entity.ReadComponent<TerrainCost>().Cost, 1, 255);
+		SetCost(cell, static_cast<uint8_t>(cost));
+	}
+
+	void NavigationGraph::SetCost(Vector2<int> cell, uint8_t cost)
+	{
+		if (!Walkability.Contains(cell) || Walkability.GetCost(cell) == cost) { return; }
+
+		Walkability.SetCost(cell, cost);
+		++Version;
+	}
+
+	void NavigationGraph::Update(EntityManager& entityManager)
+	{
+		EntityMemoryPool& pool = EntityMemoryPool::Instance();
+
+		if (BakedTileSize != Scene.TileSize)
+		{
+			Bake(entityManager);
+			FlowFields.clear();
+			LastUpdateTick = pool.GetTick();
+			return;
+		}
+
+		// Colliders that have been destroyed or lost a component no longer block anything.
+		std::erase_if(BakedColliders, [this](auto& baked)
+		{
+			Entity entity = baked.second.Owner;
+			if (entity.IsAlive() && entity.HasComponents<Position, Collider, Sprite>()) { return false; }
+
+			RebakeAround(baked.second.Position);
+			return true;
+		});
+
+		// Colliders are rare enough to check them all, rather than go through a changed view per component.
+		for (Entity entity : entityManager.GetView<Position, Collider, Sprite>())
+		{
+			const uint32_t changedTick = std::max({ entity.GetChangedTick<Position>(), entity.GetChangedTick<Collider>(), entity.GetChangedTick<Sprite>() });
+			if (changedTick < LastUpdateTick) { continue; }
+
+			const Position& position = entity.ReadComponent<Position>();
+			auto baked = BakedColliders.find(entity.GetID());
+			if (baked != BakedColliders.end() && baked->second.Owner == entity)
+			{
+				RebakeAround(baked->second.Position);
+				baked->second.Position = { position.X, position.Y };
+			}
+			else
+			{
+				BakedColliders.insert_or_assign(entity.GetID(), BakedCollider{ entity, { position.X, position.Y } });
+			}
+			RebakeAround({ position.X, position.Y });
+		}
+
+		std::erase_if(BakedTerrains, [this](auto& baked)
+		{
+			Entity entity = baked.second.Owner;
+			if (entity.IsAlive() && entity.HasComponents<Position, TerrainCost>()) { return false; }
+
+			SetCost(baked.second.Cell, WalkabilityGrid::DefaultCost);
+			return true;
+		});
+
+		for (Entity entity : entityManager.GetView<Position, TerrainCost>())
+		{
+			if (std::max(entity.GetChangedTick<Position>(), entity.GetChangedTick<TerrainCost>()) < LastUpdateTick) { continue; }
+
+			BakeTerrain(entity);
+		}
+
+		std::erase_if(FlowFields, [this](const auto& cached) { return cached.second.Version != Version; });
+		LastUpdateTick = pool.GetTick();
 	}
 
 	int NavigationGraph::GetCost(Vector2<int> current, Vector2<int> neighbour) const
 	{
-		return 1; // TODO: Query entity at positions for the relevant data to determine cost.
+		return Walkability.GetCost(GetCell(neighbour));
 	}
 
 	std::unordered_map<Vector2<int>, Vector2<int>> NavigationGraph::BreadthFirstSearch(
@@ -118,53 +303,81 @@ namespace Engine
 		return edges;
 	}
 
-	std::unordered_map<Vector2<int>, Vector2<int>> NavigationGraph::AStar(Vector2<int> start,
-		Vector2<int> goal) const
+	std::vector<Vector2<int>> NavigationGraph::AStar(Vector2<int> start, Vector2<int> goal) const
 	{
-		Vector2<int> startWorld = static_cast<Vector2<int>>(Scene.GridToWorldSpace(static_cast<Vector2<float>>(start)));
-		start = static_cast<Vector2<int>>(startWorld) + Vector2<int>{ 0, Scene.TileSize.Y / 4 };
+		std::vector<Vector2<int>> path;
+		AStar(start, goal, path);
+		return path;
+	}
 
-		Vector2<int> goalWorld = static_cast<Vector2<int>>(Scene.GridToWorldSpace(static_cast<Vector2<float>>(goal)));
-		goal = static_cast<Vector2<int>>(goalWorld) + Vector2<int>{ 0, Scene.TileSize.Y / 4 };
+	bool NavigationGraph::AStar(Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path) const
+	{
+		// Pathfinding runs on several threads at once, so each gets its own search state.
+		thread_local GridPathfinder pathfinder;
 
-		// Heuristic to expand search towards goal rather than equally in all directions.
-		auto manhattanDistance = [](const Vector2<int> lhs, const Vector2<int> rhs) { return std::abs(lhs.X - rhs.X) + std::abs(lhs.Y - rhs.Y); };
+		if (!pathfinder.AStar(Walkability, start, goal, path)) { return false; }
 
-		std::priority_queue<PriorityNode, std::vector<PriorityNode>, std::greater<>> toExplore;
-		toExplore.emplace(0, start);
-		std::unordered_map<Vector2<int>, Vector2<int>> edges;
-		edges[start] = start; // Don't want start to be added as a neighbour of another node, and don't want to use pointers or optional.
-		std::unordered_map<Vector2<int>, int> costSoFar;
-		costSoFar[start] = 0;
+		for (Vector2<int>& node : path) { node = GetNode(node); }
+		return true;
+	}
 
+	std::vector<Vector2<int>> NavigationGraph::JumpPointSearch(Vector2<int> start, Vector2<int> goal) const
+	{
+		std::vector<Vector2<int>> path;
+		JumpPointSearch(start, goal, path);
+		return path;
+	}
 
-		while (!toExplore.empty())
+	bool NavigationGraph::JumpPointSearch(Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path) const
+	{
+		thread_local GridPathfinder pathfinder;
+
+		if (!pathfinder.JumpPointSearch(Walkability, start, goal, path)) { return false; }
+
+		for (Vector2<int>& node : path) { node = GetNode(node); }
+		return true;
+	}
+
+	bool NavigationGraph::FindPath(Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path)
+	{
+		std::optional<bool> isFound = Paths.Find(start, goal, Version, path);
+		if (!isFound)
 		{
-			const Vector2<int> current = toExplore.top().second;
-			toExplore.pop();
+			thread_local GridPathfinder pathfinder;
 
-			// Early exit.
-			if (current == goal) { break; }
+			isFound = pathfinder.AStar(Walkability, start, goal, path);
+			Paths.Insert(start, goal, Version, path);
+		}
+		if (!*isFound) { return false; }
 
-			// Create a mapping from the current node to the neighbouring nodes if hasn't been found before,
-			// storing frontier nodes for later exploration.
-			const auto& neighbours = GetNeighbours(current);
-			for (auto& neighbour : neighbours)
+		for (Vector2<int>& node : path) { node = GetNode(node); }
+		return true;
+	}
+
+	const FlowField& NavigationGraph::BuildFlowField(Vector2<int> goal)
+	{
+		auto cached = FlowFields.find(goal);
+		if (cached != FlowFields.end() && cached->second.Version == Version) { return cached->second.Field; }
+
+		if (cached == FlowFields.end() && FlowFields.size() >= MAX_FLOW_FIELDS)
+		{
+			FlowFields.erase(std::min_element(FlowFields.begin(), FlowFields.end(), [](const auto& a, const auto& b)
 			{
-				int newCost = costSoFar[current] + GetCost(current, neighbour);
-				// If the neighbour hasn't already been reached or is cheaper to reach from this path, explore from its position later.
-				if (!costSoFar.contains(neighbour) || newCost < costSoFar[neighbour])
-				{
-					costSoFar[neighbour] = newCost;
-					toExplore.emplace(newCost + manhattanDistance(goal, neighbour), neighbour);
-					edges[neighbour] = current;
-				}
-			}
+				return a.second.BuildOrder < b.second.BuildOrder;
+			}));
 		}
 
-		if (!edges.contains(goal)) { return {}; }
+		CachedFlowField& built = FlowFields[goal];
+		built.Field.Build(Walkability, goal);
+		built.Version = Version;
+		built.BuildOrder = FlowFieldBuildCount++;
+		return built.Field;
+	}
 
-		return edges;
+	const FlowField* NavigationGraph::FindFlowField(Vector2<int> goal) const
+	{
+		auto cached = FlowFields.find(goal);
+		return cached != FlowFields.end() && cached->second.Version == Version ? &cached->second.Field : nullptr;
 	}
 
 	std::vector<Vector2<int>> NavigationGraph::ConstructPath(
@@ -1,10 +1,17 @@
 #pragma once
+#include "WalkabilityGrid.h"
+#include "FlowField.h"
+#include "PathCache.h"
 #include "../Maths/Vector2.h"
+#include "../EntityComponentSystem/Entity.h"
+#include <cstdint>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 namespace Engine
 {
 	class IsometricScene;
+	class EntityManager;
 
 	/// <summary>
 	/// Navigation graph to perform pathfinding. Most algorithm adapted from:
@@ -15,16 +22,94 @@ namespace Engine
 	private:
 		IsometricScene& Scene;
 
-		std::vector <Vector2<int>> Directions = 
+		/// <summary>
+		/// Nodes further than this from the world origin have no neighbours, to prevent a never ending search.
+		/// </summary>
+		static constexpr float MAX_SEARCH_DISTANCE = 1000;
+
+		WalkabilityGrid Walkability;
+		Vector2<int> BakedTileSize;
+
+		/// <summary>
+		/// Where each collider was when baked, so that the cells around it can be rebaked when it moves or is removed.
+		/// </summary>
+		struct BakedCollider
 		{
-			{1, 1}, {1, -1}, {-1, -1}, {-1, 1}, // Up, Down, Left, Right.
-			{0, -1}, {0, 1}, {-1, 0}, {1, 0} // Top Right, Bottom Left, Top Left, Bottom Right.
+			Entity Owner;
+			Vector2<float> Position;
 		};
+		std::unordered_map<size_t, BakedCollider> BakedColliders; // Keyed by entity ID.
+
+		/// <summary>
+		/// Which cell each terrain cost was baked into, so the cell can be reset when it moves or is removed.
+		/// </summary>
+		struct BakedTerrain
+		{
+			Entity Owner;
+			Vector2<int> Cell;
+		};
+		std::unordered_map<size_t, BakedTerrain> BakedTerrains; // Keyed by entity ID.
+		uint32_t LastUpdateTick = 0;
+		uint32_t Version = 0;
+
+		/// <summary>
+		/// Flow fields built for goal cells, dropped once the walkability changes.
+		/// </summary>
+		struct CachedFlowField
+		{
+			FlowField Field;
+			uint32_t Version;
+			uint64_t BuildOrder; // The oldest is replaced once there are too many.
+		};
+		static constexpr size_t MAX_FLOW_FIELDS = 8;
+		std::unordered_map<Vector2<int>, CachedFlowField> FlowFields;
+		uint64_t FlowFieldBuildCount = 0;
+
+		PathCache Paths; // Cells from start to goal, found with A*.
+
+		/// <returns>How far a collider can be from a node and still block one of its edges.</returns>
+		float GetColliderReach() const;
+
+		/// <summary>
+		/// Work out which of a cell's edges are blocked by the colliders near it.
+		/// </summary>
+		uint8_t BakeCell(Vector2<int> cell) const;
+		void Bake(EntityManager& entityManager);
+		void RebakeAround(Vector2<float> position);
+
+		/// <returns>The cell a terrain entity covers, from the centre of its tile rather than the corner it's placed at.</returns>
+		Vector2<int> GetTerrainCell(const Position& position) const;
+
+		/// <summary>
+		/// Bake a terrain cost into a cell, with the last one baked winning if several share a cell.
+		/// </summary>
+		void BakeTerrain(Entity entity);
+		void SetCost(Vector2<int> cell, uint8_t cost);
 
 	public:
 		NavigationGraph(IsometricScene& scene);
 
+		/// <summary>
+		/// Bake any colliders and terrain costs that have been added, moved or removed since the last update into the
+		/// walkability grid, rebaking it entirely if the tile size has changed. Relies on the scene's spatial hash
+		/// being up to date.
+		/// </summary>
+		void Update(EntityManager& entityManager);
+
+		/// <returns>The world space node at the centre of a grid cell.</returns>
+		Vector2<int> GetNode(Vector2<int> cell) const;
+		Vector2<int> GetCell(Vector2<int> node) const;
+
+		const WalkabilityGrid& GetWalkability() const { return Walkability; }
+
+		/// <returns>A number that changes whenever the walkability of any cell does, so paths found before can be
+		/// recognised as out of date.</returns>
+		uint32_t GetVersion() const { return Version; }
+
+		/// <returns>The nodes that can be reached directly from the given node, looked up from the baked walkability grid.</returns>
 		std::vector<Vector2<int>> GetNeighbours(Vector2<int> centralNode) const;
+
+		/// <returns>The cost of moving between adjacent nodes, which is the baked terrain cost of the one moved into.</returns>
 		int GetCost(Vector2<int> current, Vector2<int> neighbour) const;
 
 		/// <summary>
@@ -36,12 +121,58 @@ namespace Engine
 		std::unordered_map<Vector2<int>, Vector2<int>> BreadthFirstSearch(Vector2<int> start, std::optional<Vector2<int>> goal = std::nullopt) const;
 
 		/// <summary>
-		/// Explore the graph weighted towards the goal node from the starting node.
+		/// Explore the walkability grid weighted towards the goal cell from the starting cell. Search state is kept per
+		/// thread and reused, so after the first search on a thread the only allocation is the returned path.
 		/// </summary>
-		/// <param name="start">The starting node to explore from. This should be in the centre of a grid cell, not its corner, for collision accuracy.</param>
-		/// <param name="goal">The goal node to search for.</param>
-		/// <returns>A mapping of edges between nodes, empty if the goal node was not reached.</returns>
-		std::unordered_map<Vector2<int>, Vector2<int>> AStar(Vector2<int> start, Vector2<int> goal) const;
+		/// <param name="start">The grid cell to explore from.</param>
+		/// <param name="goal">The grid cell to search for.</param>
+		/// <returns>A sequence of nodes, the world space centres of cells, from the start to the goal. <br>
+		/// If a path is not possible an empty collection will be returned.</returns>
+		std::vector<Vector2<int>> AStar(Vector2<int> start, Vector2<int> goal) const;
+
+		/// <summary>
+		/// As <see cref="AStar"/>, but fills an existing path to avoid allocating.
+		/// </summary>
+		/// <returns>False if a path is not possible.</returns>
+		bool AStar(Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path) const;
+
+		/// <summary>
+		/// As <see cref="AStar"/>, finding a path of the same cost with jump point search. This expands fewer nodes but
+		/// scans further to find them, and is slower than <see cref="AStar"/> on the maps benchmarked so far, see
+		/// <see cref="GridPathfinder::JumpPointSearch"/>. Relies on <see cref="GetCost"/> being the same for every move,
+		/// so falls back to <see cref="AStar"/> once any terrain costs more.
+		/// </summary>
+		/// <returns>A sequence of nodes from the start to the goal, empty if a path is not possible.</returns>
+		std::vector<Vector2<int>> JumpPointSearch(Vector2<int> start, Vector2<int> goal) const;
+
+		/// <summary>
+		/// As <see cref="JumpPointSearch"/>, but fills an existing path to avoid allocating.
+		/// </summary>
+		/// <returns>False if a path is not possible.</returns>
+		bool JumpPointSearch(Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path) const;
+
+		/// <summary>
+		/// As <see cref="AStar"/>, but reusing the path found before between the same cells, or the rest of
+		/// a path to the same goal that passes through the start, as long as the walkability hasn't changed since.
+		/// Suits searches repeated every frame while the ends stay in the same cells. Thread safe.
+		/// </summary>
+		/// <returns>False if a path is not possible.</returns>
+		bool FindPath(Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path);
+
+		PathCache& GetPathCache() { return Paths; }
+
+		/// <summary>
+		/// Build a flow field to a goal cell, or reuse the one built since the walkability last changed. Cheaper than a
+		/// search per agent once several share the goal.
+		/// </summary>
+		/// <remarks>
+		/// Not thread safe, call between frames rather than from systems.
+		/// </remarks>
+		const FlowField& BuildFlowField(Vector2<int> goal);
+
+		/// <returns>The up to date flow field to a goal cell if one has been built, otherwise null. Safe to call from
+		/// several threads at once, as long as no flow field is being built.</returns>
+		const FlowField* FindFlowField(Vector2<int> goal) const;
 
 		/// <summary>
 		/// Constructs a path backwards from a goal node to the start node using a provided node sequence.
@@ -0,0 +1,111 @@
+#include "PathCache.h"
+#include <algorithm>
+
+namespace Engine
+{
+	PathCache::PathCache(size_t capacity) : Capacity(std::max<size_t>(capacity, 1)) {}
+
+	void PathCache::CheckVersion(uint32_t version)
+	{
+		if (version == Version) { return; }
+
+		Entries.clear();
+		EntryIndices.clear();
+		Version = version;
+	}
+
+	void PathCache::Add(const PathKey& key, std::vector<Vector2<int>> cells)
+	{
+		auto existing = EntryIndices.find(key);
+		if (existing != EntryIndices.end())
+		{
+			existing->second->Cells = std::move(cells);
+			Entries.splice(Entries.begin(), Entries, existing->second);
+			return;
+		}
+
+		if (Entries.size() >= Capacity)
+		{
+			EntryIndices.erase(Entries.back().Key);
+			Entries.pop_back();
+		}
+		Entries.push_front({ key, std::move(cells) });
+		EntryIndices.emplace(key, Entries.begin());
+	}
+
+	std::optional<bool> PathCache::Find(Vector2<int> start, Vector2<int> goal, uint32_t version, std::vector<Vector2<int>>& path)
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		if (version < Version)
+		{
+			++MissCount;
+			return std::nullopt;
+		}
+		CheckVersion(version);
+
+		const PathKey key = { start, goal, version };
+		auto existing = EntryIndices.find(key);
+		if (existing != EntryIndices.end())
+		{
+			Entries.splice(Entries.begin(), Entries, existing->second);
+			path = existing->second->Cells;
+			++HitCount;
+			return !path.empty();
+		}
+
+		// A start further along a path to the same goal, such as an agent following it, can take the rest of the path.
+		for (auto entry = Entries.begin(); entry != Entries.end(); ++entry)
+		{
+			if (entry->Key.Goal != goal) { continue; }
+
+			auto cell = std::find(entry->Cells.begin(), entry->Cells.end(), start);
+			if (cell == entry->Cells.end()) { continue; }
+
+			path.assign(cell, entry->Cells.end());
+			Add(key, path);
+			++HitCount;
+			return true;
+		}
+
+		++MissCount;
+		return std::nullopt;
+	}
+
+	void PathCache::Insert(Vector2<int> start, Vector2<int> goal, uint32_t version, const std::vector<Vector2<int>>& path)
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+
+		// A search that started before the map changed has nothing to add.
+		if (version < Version) { return; }
+		CheckVersion(version);
+
+		Add({ start, goal, version }, path);
+	}
+
+	void PathCache::Clear()
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		Entries.clear();
+		EntryIndices.clear();
+		HitCount = 0;
+		MissCount = 0;
+	}
+
+	size_t PathCache::GetSize()
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		return Entries.size();
+	}
+
+	size_t PathCache::GetHitCount()
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		return HitCount;
+	}
+
+	size_t PathCache::GetMissCount()
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		return MissCount;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "../Maths/Vector2.h"
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Least recently used cache of paths between grid cells, so the same search isn't repeated every frame while
+	/// neither end has moved to another cell. A start that lies along a cached path to the same goal reuses the rest
+	/// of that path, as it's the cheapest way from there too.
+	/// </summary>
+	/// <remarks>
+	/// Paths are only valid for the version of the map they were found on. Once a newer version is seen the whole
+	/// cache is dropped. Thread safe.
+	/// </remarks>
+	class PathCache
+	{
+		struct PathKey
+		{
+			Vector2<int> Start;
+			Vector2<int> Goal;
+			uint32_t Version;
+
+			bool operator==(const PathKey& other) const { return Start == other.Start && Goal == other.Goal && Version == other.Version; }
+		};
+
+		struct KeyHash
+		{
+			size_t operator()(const PathKey& key) const
+			{
+				return (std::hash<Vector2<int>>()(key.Start) * 31 + std::hash<Vector2<int>>()(key.Goal)) * 31 + key.Version;
+			}
+		};
+
+		struct Entry
+		{
+			PathKey Key;
+			std::vector<Vector2<int>> Cells; // Empty if there was no path.
+		};
+
+		size_t Capacity;
+		std::mutex Mutex; // Guards everything below.
+		std::list<Entry> Entries; // Most recently used first.
+		std::unordered_map<PathKey, std::list<Entry>::iterator, KeyHash> EntryIndices;
+		uint32_t Version = 0;
+		size_t HitCount = 0;
+		size_t MissCount = 0;
+
+		/// <summary>
+		/// Drop everything if the version has changed, as none of it can be trusted anymore.
+		/// </summary>
+		void CheckVersion(uint32_t version);
+
+		void Add(const PathKey& key, std::vector<Vector2<int>> cells);
+
+	public:
+		explicit PathCache(size_t capacity = 64);
+
+		/// <summary>
+		/// Look up a path between cells, either cached for the same start or following on from a cached path that
+		/// passes through the start.
+		/// </summary>
+		/// <param name="path">Filled with the cells from the start to the goal if cached.</param>
+		/// <returns>Nothing if the path isn't cached, otherwise whether there is a path.</returns>
+		std::optional<bool> Find(Vector2<int> start, Vector2<int> goal, uint32_t version, std::vector<Vector2<int>>& path);
+
+		/// <summary>
+		/// Store a path found between cells, replacing the least recently used one if full.
+		/// </summary>
+		/// <param name="path">The cells from the start to the goal, empty if there is no path.</param>
+		void Insert(Vector2<int> start, Vector2<int> goal, uint32_t version, const std::vector<Vector2<int>>& path);
+
+		void Clear();
+
+		size_t GetSize();
+		size_t GetHitCount();
+		size_t GetMissCount();
+	};
+}
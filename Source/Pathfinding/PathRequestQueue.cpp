@@ -0,0 +1,134 @@
+#include "PathRequestQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace Engine
+{
+	PathRequestQueue::PathRequestQueue(Solver solver, std::chrono::microseconds budget) : Solve(std::move(solver)), Budget(budget) {}
+
+	void PathRequestQueue::Request(Entity entity, Vector2<int> start, Vector2<int> goal)
+	{
+		std::unique_lock<std::mutex> lock(PendingMutex);
+
+		// Re-requesting keeps the original place in the queue.
+		auto [pending, isAdded] = PendingIndices.try_emplace(entity.GetID(), Pending.size());
+		if (isAdded) { Pending.push_back({ entity, start, goal }); }
+		else { Pending[pending->second] = { entity, start, goal }; }
+	}
+
+	void PathRequestQueue::Process(ThreadPool& pool, uint32_t version)
+	{
+		EntityMemoryPool& entityPool = EntityMemoryPool::Instance();
+		if (Results.size() < entityPool.GetCapacity()) { Results.resize(entityPool.GetCapacity()); }
+
+		std::unique_lock<std::mutex> lock(PendingMutex);
+
+		// Group requests for the same path, in the order they were first asked for.
+		size_t batchCount = 0;
+		BatchIndices.clear();
+		for (const PendingRequest& request : Pending)
+		{
+			if (!request.Owner.IsAlive()) { continue; }
+
+			auto [index, isAdded] = BatchIndices.try_emplace({ request.Start, request.Goal }, batchCount);
+			if (isAdded)
+			{
+				if (Batches.size() <= batchCount) { Batches.emplace_back(); }
+
+				Batch& batch = Batches[batchCount++];
+				batch.Start = request.Start;
+				batch.Goal = request.Goal;
+				batch.Owners.clear();
+				batch.IsSolved = false;
+				batch.IsFlowField = false;
+			}
+			Batches[index->second].Owners.push_back(request.Owner);
+		}
+
+		// Crowds heading to the same goal share a flow field, built once however many different starts they have.
+		if (BuildField)
+		{
+			GoalCounts.clear();
+			for (size_t i = 0; i < batchCount; ++i) { GoalCounts[Batches[i].Goal] += Batches[i].Owners.size(); }
+
+			for (size_t i = 0; i < batchCount; ++i)
+			{
+				Batch& batch = Batches[i];
+				size_t& count = GoalCounts[batch.Goal];
+				if (count < FlowFieldThreshold) { continue; }
+
+				// Marked once built, so the goal's other batches don't build it again.
+				constexpr size_t Built = std::numeric_limits<size_t>::max();
+				if (count != Built)
+				{
+					BuildField(batch.Goal);
+					count = Built;
+				}
+				batch.IsSolved = true;
+				batch.IsFlowField = true;
+			}
+		}
+
+		// Each thread takes the next batch until they run out or the budget does. The first is always solved, so
+		// however small the budget requests still get through.
+		size_t first = 0;
+		while (first < batchCount && Batches[first].IsSolved) { ++first; }
+
+		const auto deadline = std::chrono::steady_clock::now() + Budget;
+		std::atomic<size_t> next = first;
+		const size_t threadCount = std::min(std::max<size_t>(pool.GetThreadCount(), 1), batchCount - first);
+		pool.ParallelFor(0, threadCount, 1, [this, &next, first, batchCount, deadline](size_t, size_t)
+		{
+			for (size_t i = next++; i < batchCount; i = next++)
+			{
+				Batch& batch = Batches[i];
+				if (batch.IsSolved) { continue; }
+				if (i > first && std::chrono::steady_clock::now() >= deadline) { return; }
+
+				batch.IsFound = Solve(batch.Start, batch.Goal, batch.Nodes);
+				batch.IsSolved = true;
+			}
+		});
+
+		for (size_t i = 0; i < batchCount; ++i)
+		{
+			const Batch& batch = Batches[i];
+			if (!batch.IsSolved || batch.IsFlowField) { continue; }
+
+			for (Entity owner : batch.Owners)
+			{
+				Result& result = Results[owner.GetID()];
+				result.Value.Goal = batch.Goal;
+				result.Value.Nodes.clear();
+				if (batch.IsFound) { result.Value.Nodes.insert(result.Value.Nodes.end(), batch.Nodes.begin(), batch.Nodes.end()); }
+				result.Value.Next = 1;
+				result.Value.Version = version;
+				result.Generation = owner.GetGeneration();
+				result.IsSet = true;
+			}
+		}
+
+		// Anything unsolved waits for the next call, keeping its place.
+		std::erase_if(Pending, [this](const PendingRequest& request)
+		{
+			return !request.Owner.IsAlive() || Batches[BatchIndices.at({ request.Start, request.Goal })].IsSolved;
+		});
+		PendingIndices.clear();
+		for (size_t i = 0; i < Pending.size(); ++i) { PendingIndices.emplace(Pending[i].Owner.GetID(), i); }
+	}
+
+	PathRequestQueue::Path* PathRequestQueue::GetPath(Entity entity)
+	{
+		if (entity.GetID() >= Results.size()) { return nullptr; }
+
+		Result& result = Results[entity.GetID()];
+		return result.IsSet && result.Generation == entity.GetGeneration() ? &result.Value : nullptr;
+	}
+
+	size_t PathRequestQueue::GetPendingCount()
+	{
+		std::unique_lock<std::mutex> lock(PendingMutex);
+		return Pending.size();
+	}
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include "../Maths/Vector2.h"
+#include "../EntityComponentSystem/Entity.h"
+#include "../Core/ThreadPool.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// Collects path requests from entities and solves them in batches on a thread pool, so that many agents needing
+	/// a path at once spreads over frames instead of stalling one. Requests for the same start and goal are only
+	/// solved once, and each entity's solved path is kept whole for it to follow.
+	/// </summary>
+	/// <remarks>
+	/// Requests can be made from several threads at once, such as from a system's chunks. Paths can be read and
+	/// followed at the same time, each by the thread handling its entity, but not while <see cref="Process"/> runs.
+	/// </remarks>
+	class PathRequestQueue
+	{
+	public:
+		/// <summary>
+		/// Fills a path from start to goal, returning false if there isn't one. Called from several threads at once.
+		/// </summary>
+		using Solver = std::function<bool(Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path)>;
+
+		/// <summary>
+		/// Builds a flow field to a goal, for when enough entities are heading there that it's cheaper than a path each.
+		/// </summary>
+		using FieldBuilder = std::function<void(Vector2<int> goal)>;
+
+		struct Path
+		{
+			Vector2<int> Goal; // The goal cell the path was requested for.
+			std::vector<Vector2<int>> Nodes; // Empty if there was no path.
+			size_t Next = 1; // The node to head to next, after the start.
+			uint32_t Version = 0; // Of the map the path was found on, see Process.
+		};
+
+	private:
+		struct PendingRequest
+		{
+			Entity Owner;
+			Vector2<int> Start;
+			Vector2<int> Goal;
+		};
+
+		struct BatchKey
+		{
+			Vector2<int> Start;
+			Vector2<int> Goal;
+
+			bool operator==(const BatchKey& other) const { return Start == other.Start && Goal == other.Goal; }
+		};
+
+		struct BatchKeyHash
+		{
+			size_t operator()(const BatchKey& key) const
+			{
+				return std::hash<Vector2<int>>()(key.Start) * 31 + std::hash<Vector2<int>>()(key.Goal);
+			}
+		};
+
+		/// <summary>
+		/// Every entity asking for the same path.
+		/// </summary>
+		struct Batch
+		{
+			Vector2<int> Start;
+			Vector2<int> Goal;
+			std::vector<Entity> Owners;
+			std::vector<Vector2<int>> Nodes;
+			bool IsFound = false;
+			bool IsSolved = false;
+			bool IsFlowField = false; // Solved by building a flow field to the goal rather than a path.
+		};
+
+		struct Result
+		{
+			Path Value;
+			uint32_t Generation = 0;
+			bool IsSet = false;
+		};
+
+		Solver Solve;
+		std::chrono::microseconds Budget;
+		FieldBuilder BuildField;
+		size_t FlowFieldThreshold = 0;
+
+		std::mutex PendingMutex; // Guards Pending and PendingIndices.
+		std::vector<PendingRequest> Pending; // Oldest first, so nothing waits forever behind newer requests.
+		std::unordered_map<size_t, size_t> PendingIndices; // Entity ID to its request, so re-requesting replaces it.
+
+		std::vector<Batch> Batches; // Kept between frames to reuse their memory.
+		std::unordered_map<BatchKey, size_t, BatchKeyHash> BatchIndices;
+		std::unordered_map<Vector2<int>, size_t> GoalCounts;
+		std::vector<Result> Results; // Indexed by entity ID.
+
+	public:
+		explicit PathRequestQueue(Solver solver, std::chrono::microseconds budget = std::chrono::microseconds(2000));
+
+		/// <summary>
+		/// Ask for a path for an entity, replacing any it has already asked for that hasn't been solved yet.
+		/// </summary>
+		void Request(Entity entity, Vector2<int> start, Vector2<int> goal);
+
+		/// <summary>
+		/// Solve waiting requests, oldest first, until the time budget runs out. At least one is always solved so that
+		/// requests can't be stuck forever, the rest wait for the next call. Flow fields are built first, regardless of
+		/// the budget, as each one takes care of many requests.
+		/// </summary>
+		/// <param name="version">Stamped onto solved paths, so that followers can tell when the map has changed since.</param>
+		void Process(ThreadPool& pool, uint32_t version);
+
+		/// <returns>The path last solved for an entity, or null if there isn't one.</returns>
+		Path* GetPath(Entity entity);
+
+		/// <returns>How many requests are waiting to be solved.</returns>
+		size_t GetPendingCount();
+
+		/// <summary>
+		/// Once at least the threshold of entities are waiting on paths to the same goal, build a flow field for them
+		/// to follow instead. Their requests are then dropped without a path being stored for them.
+		/// </summary>
+		void SetFieldBuilder(FieldBuilder builder, size_t threshold)
+		{
+			BuildField = std::move(builder);
+			FlowFieldThreshold = threshold;
+		}
+
+		void SetBudget(std::chrono::microseconds budget) { Budget = budget; }
+		std::chrono::microseconds GetBudget() const { return Budget; }
+	};
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "../Maths/Vector2.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	/// <summary>
+	/// A dense grid storing, for each cell, which of its eight neighbours can be moved to directly and the cost of
+	/// moving into it. Baked from colliders and terrain by <see cref="NavigationGraph"/> so that finding a node's
+	/// neighbours is a lookup rather than collision tests.
+	/// </summary>
+	class WalkabilityGrid
+	{
+		std::vector<uint8_t> Masks; // Bit i is set if the cell can be left towards Directions[i].
+		std::vector<uint8_t> Costs; // Kept apart from the masks so searches that ignore costs don't load them.
+		size_t WeightedCount = 0; // Cells costing more than DefaultCost.
+		Vector2<int> Origin; // Grid coordinates of the first cell.
+		Vector2<int> Size;
+
+	public:
+		/// <summary>
+		/// Offsets to each neighbour in grid coordinates, in mask bit order.
+		/// </summary>
+		static inline const std::array<Vector2<int>, 8> Directions =
+		{
+			Vector2<int>{1, 1}, {1, -1}, {-1, -1}, {-1, 1}, // Up, Down, Left, Right.
+			{0, -1}, {0, 1}, {-1, 0}, {1, 0} // Top Right, Bottom Left, Top Left, Bottom Right.
+		};
+
+		static constexpr uint8_t AllDirections = 0xFF;
+
+		/// <summary>
+		/// The cost of moving into a cell, in any direction, unless terrain says otherwise. Also the cheapest a move
+		/// can be, which heuristics rely on.
+		/// </summary>
+		static constexpr uint8_t DefaultCost = 1;
+
+		/// <returns>The index in <see cref="Directions"/> of a unit offset, which must not be zero.</returns>
+		static size_t GetDirectionIndex(Vector2<int> direction)
+		{
+			// Laid out by (Y + 1) * 3 + (X + 1), with the centre unused.
+			static constexpr std::array<uint8_t, 9> Indices = { 2, 4, 1, 6, 0, 7, 3, 5, 0 };
+			return Indices[(direction.Y + 1) * 3 + (direction.X + 1)];
+		}
+
+		/// <summary>
+		/// Cover the given cells, every one starting with the given walkable directions and the default cost.
+		/// </summary>
+		void Resize(Vector2<int> origin, Vector2<int> size, uint8_t mask = 0)
+		{
+			Origin = origin;
+			Size = size;
+			Masks.assign(static_cast<size_t>(size.X) * size.Y, mask);
+			Costs.assign(Masks.size(), DefaultCost);
+			WeightedCount = 0;
+		}
+
+		Vector2<int> GetOrigin() const { return Origin; }
+		Vector2<int> GetSize() const { return Size; }
+		size_t GetCellCount() const { return Masks.size(); }
+
+		bool Contains(Vector2<int> cell) const
+		{
+			return cell.X >= Origin.X && cell.Y >= Origin.Y && cell.X < Origin.X + Size.X && cell.Y < Origin.Y + Size.Y;
+		}
+
+		/// <summary>
+		/// Cells are stored row by row, only valid for cells the grid contains.
+		/// </summary>
+		size_t GetIndex(Vector2<int> cell) const
+		{
+			return static_cast<size_t>(cell.Y - Origin.Y) * Size.X + (cell.X - Origin.X);
+		}
+
+		Vector2<int> GetCell(size_t index) const
+		{
+			return { static_cast<int>(index % Size.X) + Origin.X, static_cast<int>(index / Size.X) + Origin.Y };
+		}
+
+		/// <returns>The walkable directions, none for cells outside the grid.</returns>
+		uint8_t GetMask(Vector2<int> cell) const { return Contains(cell) ? Masks[GetIndex(cell)] : 0; }
+		uint8_t GetMask(size_t index) const { return Masks[index]; }
+
+		void SetMask(Vector2<int> cell, uint8_t mask)
+		{
+			if (Contains(cell)) { Masks[GetIndex(cell)] = mask; }
+		}
+
+		bool CanMove(Vector2<int> cell, size_t direction) const { return GetMask(cell) & (1u << direction); }
+
+		/// <summary>
+		/// Block a cell from both sides, as a collider would, so it can't be left or moved into from its neighbours.
+		/// </summary>
+		void BlockCell(Vector2<int> cell)
+		{
+			SetMask(cell, 0);
+			for (size_t direction = 0; direction < Directions.size(); ++direction)
+			{
+				const Vector2<int> neighbour = cell + Directions[direction];
+				SetMask(neighbour, GetMask(neighbour) & ~(1u << GetDirectionIndex(-Directions[direction])));
+			}
+		}
+
+		/// <returns>The cost of moving into a cell, only valid for cells the grid contains.</returns>
+		uint8_t GetCost(size_t index) const { return Costs[index]; }
+		uint8_t GetCost(Vector2<int> cell) const { return Contains(cell) ? Costs[GetIndex(cell)] : DefaultCost; }
+
+		/// <summary>
+		/// Set the cost of moving into a cell, raised to the default if below it.
+		/// </summary>
+		void SetCost(Vector2<int> cell, uint8_t cost)
+		{
+			if (!Contains(cell)) { return; }
+
+			uint8_t& current = Costs[GetIndex(cell)];
+			cost = std::max(cost, DefaultCost);
+			WeightedCount += (cost != DefaultCost) - (current != DefaultCost);
+			current = cost;
+		}
+
+		/// <returns>True if every cell has the default cost, so searches can treat every move as costing the same.</returns>
+		bool IsUniformCost() const { return WeightedCount == 0; }
+	};
+}
@@ -5,6 +5,7 @@
 #include "../EntityComponentSystem/Entity.h"
 #include "../EntityComponentSystem/EntityManager.h"
 #include "../EntityComponentSystem/Systems/BaseSystem.h"
+#include "../EntityComponentSystem/Systems/SystemScheduler.h"
 #include "../Input/Input.h"
 #include <execution>
 #include <memory>
@@ -20,6 +21,7 @@ namespace Engine
 	{
 	private:
 		ThreadPool Pool;
+		SystemScheduler Scheduler{ Pool };
 
 	protected:
 		EntityManager ManagedEntityManager;
@@ -29,7 +31,7 @@ namespace Engine
 		Entity MainCamera;
 		Input InputManager;
 
-		BaseScene(const float& deltaTime) : MainCamera{ ManagedEntityManager.AddEntity("Camera") }
+		BaseScene(const float& deltaTime) : MainCamera{ ManagedEntityManager.AddEntity(Tags::Camera) }
 		{
 			MainCamera.AddComponent<Position>();
 			MainCamera.AddComponent<Velocity>();
@@ -47,16 +49,16 @@ namespace Engine
 		{
 			ManagedEntityManager.Update();
 
-			for (const auto& system : Systems)
-			{
-				Pool.QueueJob([&system, deltaTime]() { system->Update(deltaTime); });
-			}
+			// Blocks until every system has finished, so nothing is still writing components once rendering starts.
+			Scheduler.Run(Systems, deltaTime);
 
-			Pool.Busy();
+			// Sync point, structural changes recorded by systems are made now that none are running.
+			Scheduler.PlaybackCommands(ManagedEntityManager);
 		}
 		virtual void Render(Renderer& renderer) = 0;
 
 		EntityManager& GetEntityManager() { return ManagedEntityManager; }
+		ThreadPool& GetThreadPool() { return Pool; }
 
 		/// <summary>
 		/// Converts screen space coordinates (pixels) to world space coordinates (pixels), taking into account camera offset and zoom.
@@ -70,8 +72,8 @@ namespace Engine
 		{
 			// Do the opposite of WorldSpaceToRenderSpace!
 			Vector2<float> world = ((screen - (Vector2<float>)Events::Instance().GetWindowSize() / 2) // Account for centred screen...
-				/ MainCamera.GetComponent<Zoom>().Value) // ... zoom...
-				+ MainCamera.GetComponent<Position>(); // and camera position. 
+				/ MainCamera.ReadComponent<Zoom>().Value) // ... zoom...
+				+ MainCamera.ReadComponent<Position>(); // and camera position. 
 			return world;
 		}
 
@@ -87,8 +89,8 @@ namespace Engine
 		virtual Vector2<float> WorldSpaceToRenderSpace(Vector2<float> world) const
 		{
 			// Do the opposite of ScreenSpaceToWorldSpace!
-			Vector2<float> render = (world - MainCamera.GetComponent<Position>()) // Account for camera position...
-				* MainCamera.GetComponent<Zoom>().Value  // ... zoom...
+			Vector2<float> render = (world - MainCamera.ReadComponent<Position>()) // Account for camera position...
+				* MainCamera.ReadComponent<Zoom>().Value  // ... zoom...
 				+ (Vector2<float>)Events::Instance().GetWindowSize() / 2; // ... and centred screen. 
 			return render;
 		}
@@ -0,0 +1,44 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+
+namespace Engine
+{
+	/// <summary>
+	/// Packs what an isometric scene draws in order of, Z then Y, along with an index into a single integer so that
+	/// sprites can be put in draw order by sorting integers, see <see cref="RadixSort"/>.
+	/// </summary>
+	/// <remarks>
+	/// From the most significant bit: Z offset to be unsigned, Y as bits that compare the same way the float does, then
+	/// the index. Y keeps full precision, so keys order exactly as comparing Z then Y would, with ties in index order.
+	/// </remarks>
+	namespace DepthKey
+	{
+		inline constexpr int ZBits = 12;
+		inline constexpr int YBits = 32;
+		inline constexpr int IndexBits = 64 - ZBits - YBits;
+		inline constexpr int MinZ = -(1 << (ZBits - 1));
+		inline constexpr int MaxZ = (1 << (ZBits - 1)) - 1;
+		inline constexpr uint64_t MaxIndex = (uint64_t(1) << IndexBits) - 1;
+
+		/// <returns>False if the Z or index don't fit, in which case compare instead.</returns>
+		inline bool CanPack(int z, uint64_t index)
+		{
+			return z >= MinZ && z <= MaxZ && index <= MaxIndex;
+		}
+
+		inline uint64_t Pack(int z, float y, uint64_t index)
+		{
+			// Flipping every bit of negatives and the sign bit of positives puts them in the same order as unsigned.
+			// Adding zero turns -0 into 0, as they compare equal.
+			const uint32_t bits = std::bit_cast<uint32_t>(y + 0.f);
+			const uint32_t orderedY = bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+			return (uint64_t(z - MinZ) << (YBits + IndexBits)) | (uint64_t(orderedY) << IndexBits) | index;
+		}
+
+		inline uint64_t GetIndex(uint64_t key)
+		{
+			return key & MaxIndex;
+		}
+	}
+}
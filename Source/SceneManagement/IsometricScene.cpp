@@ -17,7 +17,9 @@
 #include "../Input/Conditions/PressedCondition.h"
 #include "../Input/Conditions/ReleasedCondition.h"
 #include "../Pathfinding/NavigationGraph.h"
-#include <execution>
+#include "../Collision/Intersections.h"
+#include <limits>
+#include <map>
 #include <memory>
 #include <numbers>
 #include <SDL.h>
@@ -25,7 +27,9 @@
 
 namespace Engine
 {
-	IsometricScene::IsometricScene(const float& deltaTime) : BaseScene(deltaTime), ManagedNavigationGraph(NavigationGraph(*this)), Editor(std::make_unique<EditorSystem>(*this))
+	IsometricScene::IsometricScene(const float& deltaTime) : BaseScene(deltaTime), ManagedNavigationGraph(NavigationGraph(*this)),
+		ManagedPathRequests([this](Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path) { return ManagedNavigationGraph.FindPath(start, goal, path); }),
+		Editor(std::make_unique<EditorSystem>(*this))
 	{
 		// Base class constructor is called implicitly.
 		// Initialiser lists copy construct, and because unique pointers can't be copy constructed need to add to the vector instead.
@@ -33,8 +37,11 @@ namespace Engine
 		Systems.emplace_back(std::make_unique<AnimationSystem>(*this));
 		Systems.emplace_back(std::make_unique<PathfindingSystem>(*this));
 
+		// Crowds sent to the same place share a flow field rather than searching for a path each.
+		ManagedPathRequests.SetFieldBuilder([this](Vector2<int> goal) { ManagedNavigationGraph.BuildFlowField(goal); }, 8);
+
 		// Player Character
-		Entity player = GetEntityManager().AddEntity("Player");
+		Entity player = GetEntityManager().AddEntity(Tags::Player);
 		player.AddComponent<Position>();
 		player.AddComponent<Velocity>();
 		player.AddComponent<Animation>();
@@ -42,7 +49,7 @@ namespace Engine
 		player.AddComponent<Sprite>();
 
 		Sprite& sprite = player.GetComponent<Sprite>();
-		strcpy(sprite.TextureName, "AnimationSheet.png");
+		sprite.Texture = TextureRegistry::Instance().GetId("AnimationSheet.png");
 		sprite.SourceRectangle = { {}, TileSize};
 		sprite.PivotOffset = { static_cast<float>(TileSize.X) / 2.f, static_cast<float>(TileSize.Y) / 1.5f };
 
@@ -77,7 +84,7 @@ namespace Engine
 
 			const Vector2<float> goal = ScreenSpaceToGrid(ImGui::GetMousePos());
 
-			Pathfinding& pathfinding = GetEntityManager().GetEntitiesByTag("Player")[0].GetComponent<Pathfinding>();
+			Pathfinding& pathfinding = GetEntityManager().GetEntitiesByTag(Tags::Player)[0].GetComponent<Pathfinding>();
 			pathfinding.Current = {};
 			pathfinding.Goal = goal;
 		};
@@ -89,14 +96,17 @@ namespace Engine
 
 		std::function saveBehaviour = [this]()
 		{
-			GetEntityManager().Save("Test");
+			if (!GetEntityManager().Save("Test")) { SDL_Log("Failed to save scene \"Test\""); }
 		};
 
 		std::function loadBehaviour = [this]()
 		{
-			ManagedEntityManager = EntityManager();
-			ManagedEntityManager.Load("Test");
-			MainCamera = ManagedEntityManager.GetEntitiesByTag("Camera")[0];
+			if (!ManagedEntityManager.Load("Test"))
+			{
+				SDL_Log("Failed to load scene \"Test\"");
+				return;
+			}
+			MainCamera = ManagedEntityManager.GetEntitiesByTag(Tags::Camera)[0];
 		};
 
 		// Input Binding
@@ -160,6 +170,14 @@ namespace Engine
 	void IsometricScene::Update(const float& deltaTime)
 	{
 		BaseScene::Update(deltaTime);
+
+		// After systems have moved things and their commands have been played back, so the editor and rendering see
+		// where everything is now.
+		ManagedSpatialHash.Update(GetEntityManager());
+		ManagedRenderList.Update(GetEntityManager());
+		ManagedTileChunks.Update(ManagedRenderList);
+		ManagedNavigationGraph.Update(GetEntityManager());
+		ManagedPathRequests.Process(GetThreadPool(), ManagedNavigationGraph.GetVersion());
 		Editor->Update(deltaTime);
 	}
 
@@ -171,12 +189,37 @@ namespace Engine
 
 	void IsometricScene::RenderScene(Renderer& renderer)
 	{
-		float zoom = MainCamera.GetComponent<Zoom>().Value;
+		float zoom = MainCamera.ReadComponent<Zoom>().Value;
+		const Vector2<float> lowerBound = ScreenSpaceToWorldSpace({ 0.f, 0.f });
+		const Vector2<float> upperBound = ScreenSpaceToWorldSpace((Vector2<float>)Events::Instance().GetWindowSize());
+		const Rectangle<float> visibleArea = { lowerBound, upperBound - lowerBound };
+
+		++FrameCount;
+		if (Events::Instance().WereRenderTargetsReset()) { ManagedTileChunks.InvalidateAll(); }
+		BakeTileChunks(renderer, visibleArea);
+
+		// Chunks are drawn beneath the sprites with the same Z, as they're baked without knowing where sprites will be.
+		// Only tiles without colliders are baked, which nothing should stand behind.
+		auto& chunks = ManagedTileChunks.GetChunks();
+		auto nextChunk = chunks.begin();
+		auto renderChunksUpTo = [&](int z)
+		{
+			for (; nextChunk != chunks.end() && nextChunk->first.Z <= z; ++nextChunk)
+			{
+				TileChunks::Chunk& chunk = nextChunk->second;
+				if (!chunk.IsBaked() || !IsChunkVisible(nextChunk->first, chunk, visibleArea)) { continue; }
+
+				const Vector2<int> size = chunk.Baked.GetSize();
+				renderer.BatchSprite(chunk.Baked, { {}, size }, { WorldSpaceToRenderSpace(chunk.Bounds.Position), (Vector2<float>)size * zoom });
+				chunk.LastDrawnFrame = FrameCount;
+			}
+		};
+
 		for (auto& entity : GetRenderableEntities()) // By handling sprite entities on the scene any special sorting logic can be handled.
 		{
-			Position& position = entity.GetComponent<Position>();
-			Sprite& sprite = entity.GetComponent<Sprite>();
-			if (sprite.TextureName[0] == '\0')
+			const Position& position = entity.ReadComponent<Position>();
+			const Sprite& sprite = entity.ReadComponent<Sprite>();
+			if (sprite.Texture == NoTexture)
 			{
 				// This shouldn't happen unless the sprite component is incorrectly initialised/altered.
 				// It needs the texture to be a pointer so that there's a default value for when the components 
@@ -185,13 +228,89 @@ namespace Engine
 				continue;
 			}
 
-			Texture& texture = Renderer::Instance().GetTexture(sprite.TextureName);
+			renderChunksUpTo(position.Z);
+
+			Texture& texture = renderer.GetTexture(sprite.Texture);
 			Vector2<float> renderPosition = WorldSpaceToRenderSpace(position - sprite.PivotOffset);
 			Vector2<float> renderSize = (Vector2<float>)sprite.SourceRectangle.Size * zoom;
 
 			Rectangle<float> renderRectangle = { {renderPosition.X, renderPosition.Y}, {renderSize.X, renderSize.Y} };
 
-			renderer.RenderSprite(texture, sprite.SourceRectangle, renderRectangle);
+			renderer.BatchSprite(texture, sprite.SourceRectangle, renderRectangle);
+		}
+		renderChunksUpTo(std::numeric_limits<int>::max());
+		renderer.FlushSprites();
+
+		ManagedTileChunks.Evict(MaxBakedChunks, FrameCount);
+	}
+
+	bool IsometricScene::IsChunkVisible(const TileChunks::ChunkKey& key, const TileChunks::Chunk& chunk, Rectangle<float> visibleArea) const
+	{
+		// Until baked the bounds aren't known, but tiles are only a tile in size so can't reach further than that.
+		Rectangle<float> area = chunk.IsBaked() && !chunk.IsDirty ? chunk.Bounds : ManagedTileChunks.GetArea(key);
+		if (!chunk.IsBaked() || chunk.IsDirty)
+		{
+			const Vector2<float> margin = (Vector2<float>)TileSize;
+			area = { area.Position - margin, area.Size + margin * 2 };
+		}
+		return Collision::RectangleIntersection(area, visibleArea).has_value();
+	}
+
+	void IsometricScene::BakeTileChunks(Renderer& renderer, Rectangle<float> visibleArea)
+	{
+		std::map<TileChunks::ChunkKey, std::vector<const RenderList::Item*>> chunkTiles;
+		for (auto& [key, chunk] : ManagedTileChunks.GetChunks())
+		{
+			if ((chunk.IsDirty || !chunk.IsBaked()) && IsChunkVisible(key, chunk, visibleArea)) { chunkTiles[key]; }
+		}
+		if (chunkTiles.empty()) { return; }
+
+		// The render list keeps tiles in draw order.
+		for (const RenderList::Item& item : ManagedRenderList.GetStaticItems())
+		{
+			auto tiles = chunkTiles.find(ManagedTileChunks.GetKey(item.Z, item.Position));
+			if (tiles != chunkTiles.end()) { tiles->second.push_back(&item); }
+		}
+
+		auto& chunks = ManagedTileChunks.GetChunks();
+		for (const auto& [key, tiles] : chunkTiles)
+		{
+			// Every tile in it has been deleted.
+			if (tiles.empty())
+			{
+				chunks.erase(key);
+				continue;
+			}
+
+			// Baked at a zoom of one, covering every tile's sprite.
+			Vector2<float> lower = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+			Vector2<float> upper = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+			for (const RenderList::Item* tile : tiles)
+			{
+				const Sprite& sprite = tile->Owner.ReadComponent<Sprite>();
+				const Vector2<float> topLeft = tile->Position - sprite.PivotOffset;
+				const Vector2<float> bottomRight = topLeft + (Vector2<float>)sprite.SourceRectangle.Size;
+				lower = { std::min(lower.X, topLeft.X), std::min(lower.Y, topLeft.Y) };
+				upper = { std::max(upper.X, bottomRight.X), std::max(upper.Y, bottomRight.Y) };
+			}
+			const Vector2<int> size = { static_cast<int>(std::ceil(upper.X - lower.X)), static_cast<int>(std::ceil(upper.Y - lower.Y)) };
+
+			TileChunks::Chunk& chunk = chunks[key];
+			if (!chunk.IsBaked() || chunk.Baked.GetSize() != size) { chunk.Baked = renderer.CreateRenderTarget(size); }
+			chunk.Bounds = { lower, (Vector2<float>)size };
+			chunk.IsDirty = false;
+			if (!chunk.IsBaked()) { continue; }
+
+			renderer.BeginRenderTarget(chunk.Baked);
+			for (const RenderList::Item* tile : tiles)
+			{
+				const Sprite& sprite = tile->Owner.ReadComponent<Sprite>();
+				if (sprite.Texture == NoTexture) { continue; }
+
+				const Vector2<float> renderPosition = tile->Position - sprite.PivotOffset - lower;
+				renderer.BatchSprite(renderer.GetTexture(sprite.Texture), sprite.SourceRectangle, { renderPosition, (Vector2<float>)sprite.SourceRectangle.Size });
+			}
+			renderer.EndRenderTarget();
 		}
 	}
 
@@ -201,7 +320,7 @@ namespace Engine
 
 		// TODO: Optimise. What might be better is to render once to a surface that's retained between loops and is moved according to the camera.
 		renderer.SetRenderColour(255, 0, 0, 255);
-		float zoom = MainCamera.GetComponent<Zoom>().Value;
+		float zoom = MainCamera.ReadComponent<Zoom>().Value;
 		const Vector2<float> screenSize = (Vector2<float>)Events::Instance().GetWindowSize();
 		const Vector2<float> gridSpacing = (Vector2<float>)TileSize / 2; // Don't need to bother with zoom here, as it's handled in world space based on screen size.
 		const Vector2<float> topLeftCorner = ScreenSpaceToGrid({ 0,0 }) - Vector2<float>(1, 0); // Go left across the grid a small value to hide snapping.
@@ -246,35 +365,6 @@ namespace Engine
 		}
 	}
 
-	void IsometricScene::SortEntities(std::vector<Entity>& entities)
-	{
-		// Basic isometric depth buffer that relies on all sprites being only a tile in size.
-		// Because there's overlap in isometric scenes, one way to determine render order is by sorting by Y 
-		// position so that entities closer to the top of the screen are rendered first. But because some
-		// entities need to overlap they have a Z order requiring the entities to be sorted by Y position conditionally.
-
-		// Sort by Z to get the vector into sections so that they correctly overlap one another.
-		std::sort(std::execution::par_unseq, entities.begin(), entities.end(),
-			[](Entity a, Entity b) { return a.GetComponent<Position>().Z < b.GetComponent<Position>().Z; });
-
-		// Sort each previous section as the transitions between Z layers are discovered.
-		int lastZOrderChange = 0;
-		for (size_t i = 1; i < entities.size(); ++i)
-		{
-			// This won't trigger for the final section.
-			if (entities[i-1].GetComponent<Position>().Z != entities[i].GetComponent<Position>().Z)
-			{
-				std::sort(std::execution::par_unseq, entities.begin() + lastZOrderChange, entities.begin() + i,
-					[](Entity a, Entity b) { return a.GetComponent<Position>().Y < b.GetComponent<Position>().Y; });
-				lastZOrderChange = i;
-			}
-		}
-
-		// Sort the final section.
-		std::sort(std::execution::par_unseq, entities.begin() + lastZOrderChange, entities.end(),
-			[](Entity a, Entity b) { return a.GetComponent<Position>().Y < b.GetComponent<Position>().Y; });
-	}
-
 	std::vector<Entity> IsometricScene::GetRenderableEntities()
 	{
 		// Convert screen dimensions to visible world dimensions for entity culling.
@@ -284,21 +374,12 @@ namespace Engine
 		const Vector2<float> lowerBound = ScreenSpaceToWorldSpace({0.f, 0.f});
 		const Vector2<float> upperBound = ScreenSpaceToWorldSpace((Vector2<float>)Events::Instance().GetWindowSize());
 
-		EntityManager& entityManager = GetEntityManager();
+		// Already in draw order, so only needs culling. Tiles aren't in it, as they're drawn from their chunks.
 		std::vector<Entity> renderableEntities;
-		for (auto& entity : entityManager.GetEntities())
+		ManagedRenderList.ForEachInArea({ lowerBound, upperBound - lowerBound }, [&renderableEntities](const RenderList::Item& item)
 		{
-			if (!entity.HasComponents<Position, Sprite>()) { continue; }
-
-			Position& position = entity.GetComponent<Position>();
-			if (position.X > lowerBound.X && position.X < upperBound.X
-				&& position.Y > lowerBound.Y && position.Y < upperBound.Y)
-			{
-				renderableEntities.emplace_back(entity);
-			}
-		}
-
-		SortEntities(renderableEntities);
+			renderableEntities.push_back(item.Owner);
+		});
 
 		return renderableEntities;
 	}
@@ -306,6 +387,7 @@ namespace Engine
 	void IsometricScene::SetTileSize(int width, int height)
 	{
 		TileSize = { width, height };
+		ManagedSpatialHash.SetCellSize(static_cast<float>(TileSize.X));
 	}
 
 	Vector2<float> IsometricScene::ScreenSpaceToGrid(Vector2<float> screen, bool floor) const
@@ -4,6 +4,10 @@
 #include "../Maths/Vector2.h"
 #include "../EntityComponentSystem/Entity.h"
 #include "../Pathfinding/NavigationGraph.h"
+#include "../Pathfinding/PathRequestQueue.h"
+#include "../Collision/SpatialHash.h"
+#include "RenderList.h"
+#include "TileChunks.h"
 
 namespace Engine
 {
@@ -14,6 +18,14 @@ namespace Engine
 	{
 	private:
 		std::unique_ptr<EditorSystem> Editor;
+		uint64_t FrameCount = 0;
+
+		/// <summary>
+		/// Bake the tile chunks that are on screen but out of date or evicted, gathering their tiles in one pass.
+		/// </summary>
+		void BakeTileChunks(Renderer& renderer, Rectangle<float> visibleArea);
+
+		bool IsChunkVisible(const TileChunks::ChunkKey& key, const TileChunks::Chunk& chunk, Rectangle<float> visibleArea) const;
 
 	public:
 		/// <summary>
@@ -25,18 +37,43 @@ namespace Engine
 
 		NavigationGraph ManagedNavigationGraph;
 
+		/// <summary>
+		/// Paths asked for by <see cref="PathfindingSystem"/>, solved with A* at the end of <see cref="Update"/>.
+		/// </summary>
+		PathRequestQueue ManagedPathRequests;
+
 		// There are two ways to store tile size. The first is currently used. TODO: Convert to the second?
 		// 1. Full tile size and division in calculation to get the base of the tile.
 		// 2. Just the base of the tile size, already divided.
 		Vector2<int> TileSize = { 128, 128 };
 
+		/// <summary>
+		/// Every entity with a position, bucketed by world position. Updated at the end of <see cref="Update"/>.
+		/// </summary>
+		SpatialHash ManagedSpatialHash{ static_cast<float>(TileSize.X) };
+
+		/// <summary>
+		/// Every entity with a sprite, kept in draw order between frames. Updated at the end of <see cref="Update"/>.
+		/// Tiles without colliders are static, so are kept apart and drawn from <see cref="ManagedTileChunks"/> instead.
+		/// </summary>
+		RenderList ManagedRenderList{ Tags::TileSet };
+
+		/// <summary>
+		/// Tiles baked into a texture per chunk, re-baked when tiles in them are created or deleted.
+		/// </summary>
+		TileChunks ManagedTileChunks{ static_cast<float>(TileSize.X * 4) };
+
+		/// <summary>
+		/// Chunk textures kept once off screen, beyond which the least recently seen are freed.
+		/// </summary>
+		static constexpr size_t MaxBakedChunks = 128;
+
 		void Update(const float& deltaTime) override;
 		void Render(Renderer& renderer) override;
 		void RenderScene(Renderer& renderer);
 		void RenderGrid(Renderer& renderer);
 
-		static void SortEntities(std::vector<Entity>& entities);
-
+		/// <returns>The on screen entities with a sprite that aren't tiles, in draw order.</returns>
 		std::vector<Entity> GetRenderableEntities();
 		void SetTileSize(int width, int height);
 
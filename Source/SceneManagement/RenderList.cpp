@@ -0,0 +1,164 @@
+#include "RenderList.h"
+#include "../EntityComponentSystem/EntityManager.h"
+#include "../EntityComponentSystem/Components.h"
+#include "../Maths/RadixSort.h"
+#include "DepthKey.h"
+#include <algorithm>
+
+namespace Engine
+{
+	RenderList::RenderList(std::optional<TagId> staticTag) : StaticTag(staticTag) {}
+
+	bool RenderList::IsStatic(Entity entity) const
+	{
+		return entity.GetTag() == StaticTag && !entity.HasComponent<Collider>();
+	}
+
+	bool RenderList::Track(Entity entity)
+	{
+		Entry& entry = Entries[entity.GetID()];
+		const Position& position = entity.ReadComponent<Position>();
+		const Item item = { position.Z, position.Y, static_cast<uint32_t>(entity.GetID()), entity.GetTag(), entity, { position.X, position.Y } };
+		const bool isStatic = IsStatic(entity);
+		if (isStatic) { StaticChanges.push_back({ item.Z, item.Position }); }
+
+		// The ID might have been reused by an entity in the other list since it was added.
+		if (entry.IsTracked && entry.IsStatic != isStatic) { Untrack(item.ID); }
+
+		std::vector<Item>& items = isStatic ? StaticItems : Items;
+		if (entry.IsTracked)
+		{
+			// Only moving along X doesn't change the order, so only the cached position needs updating.
+			Item& existing = items[entry.Index];
+			if (isStatic) { StaticChanges.push_back({ existing.Z, existing.Position }); }
+			const bool isKeyChanged = existing.Z != item.Z || existing.Y != item.Y || entry.Generation != entity.GetGeneration();
+			existing = item;
+			entry.Generation = entity.GetGeneration(); // The ID might have been reused since it was added.
+			return isKeyChanged;
+		}
+
+		entry = { static_cast<uint32_t>(items.size()), entity.GetGeneration(), true, isStatic };
+		items.push_back(item);
+		return true;
+	}
+
+	void RenderList::Untrack(uint32_t id)
+	{
+		Entry& entry = Entries[id];
+		std::vector<Item>& items = entry.IsStatic ? StaticItems : Items;
+		if (entry.IsStatic) { StaticChanges.push_back({ items[entry.Index].Z, items[entry.Index].Position }); }
+
+		items.erase(items.begin() + entry.Index);
+		entry = {};
+		UpdateIndices(items);
+	}
+
+	void RenderList::Repair(std::vector<Item>& items, size_t changedCount)
+	{
+		// A full sort is cheaper once enough have changed that they could have to travel far between them.
+		if (changedCount * 8 > items.size())
+		{
+			SortAll(items);
+			return;
+		}
+
+		// Insertion sort is linear over items already in order, plus however far each changed one has to move.
+		for (size_t i = 1; i < items.size(); ++i)
+		{
+			if (!items[i].IsBefore(items[i - 1])) { continue; }
+
+			const Item item = items[i];
+			size_t j = i;
+			for (; j > 0 && item.IsBefore(items[j - 1]); --j)
+			{
+				items[j] = items[j - 1];
+				Entries[items[j].ID].Index = static_cast<uint32_t>(j);
+			}
+			items[j] = item;
+			Entries[item.ID].Index = static_cast<uint32_t>(j);
+		}
+	}
+
+	void RenderList::SortAll(std::vector<Item>& items)
+	{
+		// Keys tied on Z and Y are in ID order, the same as comparing items.
+		Keys.clear();
+		for (const Item& item : items)
+		{
+			if (!DepthKey::CanPack(item.Z, item.ID))
+			{
+				std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.IsBefore(b); });
+				UpdateIndices(items);
+				return;
+			}
+			Keys.push_back(DepthKey::Pack(item.Z, item.Y, item.ID));
+		}
+
+		RadixSort(Keys, KeyBuffer);
+
+		SortedItems.clear();
+		for (uint64_t key : Keys) { SortedItems.push_back(items[Entries[DepthKey::GetIndex(key)].Index]); }
+		items.swap(SortedItems);
+		UpdateIndices(items);
+	}
+
+	void RenderList::UpdateIndices(const std::vector<Item>& items)
+	{
+		for (size_t i = 0; i < items.size(); ++i) { Entries[items[i].ID].Index = static_cast<uint32_t>(i); }
+	}
+
+	void RenderList::Update(EntityManager& entityManager)
+	{
+		EntityMemoryPool& pool = EntityMemoryPool::Instance();
+		if (Entries.size() < pool.GetCapacity()) { Entries.resize(pool.GetCapacity()); }
+
+		StaticChanges.clear();
+
+		// Gaining a sprite doesn't change the position, so both need checking for new entities. Gaining a collider moves
+		// a tile out of the static items.
+		size_t changedCount = 0;
+		size_t staticChangedCount = 0;
+		auto track = [&](Entity entity)
+		{
+			if (Track(entity)) { ++(Entries[entity.GetID()].IsStatic ? staticChangedCount : changedCount); }
+		};
+		for (Entity entity : entityManager.GetView<Changed<Position>, Sprite>(LastUpdateTick)) { track(entity); }
+		for (Entity entity : entityManager.GetView<Position, Changed<Sprite>>(LastUpdateTick)) { track(entity); }
+		for (Entity entity : entityManager.GetView<Position, Sprite, Changed<Collider>>(LastUpdateTick)) { track(entity); }
+		LastUpdateTick = pool.GetTick();
+
+		// Every entity with a position and sprite is tracked, so any more than that means some have been destroyed or
+		// lost one. Removing keeps the rest in order, so only their indices need fixing. Static items are only searched
+		// if there are still too many, so removing dynamic ones doesn't cost anything per static one.
+		const size_t renderableCount = entityManager.GetView<Position, Sprite>().size();
+		auto removeUntracked = [this, &pool](std::vector<Item>& items)
+		{
+			std::erase_if(items, [this, &pool](const Item& item)
+			{
+				Entry& entry = Entries[item.ID];
+				if (pool.IsValid(item.ID, entry.Generation) && pool.HasComponent<Position>(item.ID) && pool.HasComponent<Sprite>(item.ID))
+				{
+					return false;
+				}
+
+				if (entry.IsStatic) { StaticChanges.push_back({ item.Z, item.Position }); }
+				entry = {};
+				return true;
+			});
+			UpdateIndices(items);
+		};
+		if (size() > renderableCount) { removeUntracked(Items); }
+		if (size() > renderableCount) { removeUntracked(StaticItems); }
+
+		if (changedCount > 0) { Repair(Items, changedCount); }
+		if (staticChangedCount > 0) { Repair(StaticItems, staticChangedCount); }
+	}
+
+	void RenderList::Clear()
+	{
+		Items.clear();
+		StaticItems.clear();
+		StaticChanges.clear();
+		std::fill(Entries.begin(), Entries.end(), Entry{});
+	}
+}
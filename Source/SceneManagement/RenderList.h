@@ -0,0 +1,142 @@
+#pragma once
+#include "../Maths/Vector2.h"
+#include "../Maths/Rectangle.h"
+#include "../EntityComponentSystem/Entity.h"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Engine
+{
+	class EntityManager;
+
+	/// <summary>
+	/// Every entity with a <see cref="Position"/> and a <see cref="Sprite"/>, kept in the order they should be drawn:
+	/// by Z, then by Y so that those higher up the screen are behind, then by ID so ties are drawn the same way each frame.
+	/// </summary>
+	/// <remarks>
+	/// Kept sorted across frames by <see cref="Update"/>, which only looks at entities whose position changed since the
+	/// last call. Nothing moving costs nothing, and the few that usually do only shift a few places, so they're moved
+	/// into place with an insertion sort rather than sorting everything again. Sort keys and positions are cached so
+	/// neither sorting nor culling has to read components.
+	///
+	/// Entities with the static tag and no collider, such as floor tiles, are kept in order in a separate list, so that
+	/// neither culling nor re-sorting what moves each frame has to step over them. Those with a collider, such as walls,
+	/// stay with the rest so that they're still sorted against what moves around them. Where they're added, moved or removed is also recorded
+	/// so anything caching how they look, see <see cref="TileChunks"/>, knows what to redo.
+	/// </remarks>
+	class RenderList
+	{
+	public:
+		struct Item
+		{
+			int Z;
+			float Y;
+			uint32_t ID;
+			TagId Tag;
+			Entity Owner;
+			Vector2<float> Position;
+
+			/// <returns>Whether this is drawn before the other.</returns>
+			bool IsBefore(const Item& other) const
+			{
+				if (Z != other.Z) { return Z < other.Z; }
+				if (Y != other.Y) { return Y < other.Y; }
+				return ID < other.ID;
+			}
+		};
+
+		/// <summary>
+		/// Where a static item was before or after it changed.
+		/// </summary>
+		struct StaticChange
+		{
+			int Z;
+			Vector2<float> Position;
+		};
+
+	private:
+		/// <summary>
+		/// Where an entity ID is in the items, so its key can be updated without searching.
+		/// </summary>
+		struct Entry
+		{
+			uint32_t Index = 0;
+			uint32_t Generation = 0;
+			bool IsTracked = false;
+			bool IsStatic = false; // Whether the index is into the static items.
+		};
+
+		std::vector<Item> Items; // Those that aren't static, in draw order.
+		std::vector<Item> StaticItems; // In draw order.
+		std::vector<Entry> Entries; // Indexed by entity ID.
+		uint32_t LastUpdateTick = 0;
+		std::optional<TagId> StaticTag;
+		std::vector<StaticChange> StaticChanges; // Since the start of the last update.
+
+		// Kept between sorts to avoid allocating.
+		std::vector<uint64_t> Keys;
+		std::vector<uint64_t> KeyBuffer;
+		std::vector<Item> SortedItems;
+
+		/// <returns>Whether the entity has the static tag and nothing it could be in front of or behind.</returns>
+		bool IsStatic(Entity entity) const;
+
+		/// <returns>Whether the entity was added or its sort key changed.</returns>
+		bool Track(Entity entity);
+
+		/// <summary>
+		/// Remove a tracked item, keeping the rest of its list in order.
+		/// </summary>
+		void Untrack(uint32_t id);
+
+		/// <summary>
+		/// Restore draw order after the given number of items have had their keys changed or been added.
+		/// </summary>
+		void Repair(std::vector<Item>& items, size_t changedCount);
+
+		/// <summary>
+		/// Sort every item from scratch, by radix sorting packed keys when they fit.
+		/// </summary>
+		void SortAll(std::vector<Item>& items);
+
+		void UpdateIndices(const std::vector<Item>& items);
+
+	public:
+		explicit RenderList(std::optional<TagId> staticTag = std::nullopt);
+
+		/// <summary>
+		/// Add entities that have gained a position and sprite, re-sort those whose position changed and remove those
+		/// that have been destroyed or lost either. Call after <see cref="EntityManager::Update"/> so the views are current.
+		/// </summary>
+		void Update(EntityManager& entityManager);
+
+		void Clear();
+
+		/// <returns>The number of items, static or not.</returns>
+		size_t size() const { return Items.size() + StaticItems.size(); }
+
+		/// <returns>The items that aren't static, in draw order.</returns>
+		const std::vector<Item>& GetItems() const { return Items; }
+		const std::vector<Item>& GetStaticItems() const { return StaticItems; }
+		const std::vector<StaticChange>& GetStaticChanges() const { return StaticChanges; }
+
+		/// <summary>
+		/// Call function with every item that isn't static whose position is inside the area, edges excluded, in
+		/// draw order.
+		/// </summary>
+		template<typename F>
+		void ForEachInArea(Rectangle<float> area, F&& function) const
+		{
+			const Vector2<float> upperBound = area.Position + area.Size;
+			for (const Item& item : Items)
+			{
+				if (item.Position.X > area.Position.X && item.Position.X < upperBound.X
+					&& item.Position.Y > area.Position.Y && item.Position.Y < upperBound.Y)
+				{
+					function(item);
+				}
+			}
+		}
+	};
+}
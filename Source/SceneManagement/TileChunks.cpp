@@ -0,0 +1,48 @@
+#include "TileChunks.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Engine
+{
+	TileChunks::TileChunks(float chunkSize) : ChunkSize(chunkSize) {}
+
+	TileChunks::ChunkKey TileChunks::GetKey(int z, Vector2<float> position) const
+	{
+		return { z, static_cast<int>(std::floor(position.Y / ChunkSize)), static_cast<int>(std::floor(position.X / ChunkSize)) };
+	}
+
+	Rectangle<float> TileChunks::GetArea(ChunkKey key) const
+	{
+		return { key.Column * ChunkSize, key.Row * ChunkSize, ChunkSize, ChunkSize };
+	}
+
+	void TileChunks::Invalidate(int z, Vector2<float> position)
+	{
+		Chunks[GetKey(z, position)].IsDirty = true;
+	}
+
+	void TileChunks::InvalidateAll()
+	{
+		for (auto& [key, chunk] : Chunks) { chunk.IsDirty = true; }
+	}
+
+	void TileChunks::Update(const RenderList& renderList)
+	{
+		for (const RenderList::StaticChange& change : renderList.GetStaticChanges()) { Invalidate(change.Z, change.Position); }
+	}
+
+	void TileChunks::Evict(size_t maxBakedCount, uint64_t frame)
+	{
+		std::vector<Chunk*> baked;
+		for (auto& [key, chunk] : Chunks)
+		{
+			if (chunk.IsBaked()) { baked.push_back(&chunk); }
+		}
+		if (baked.size() <= maxBakedCount) { return; }
+
+		// Those on screen are kept even if over the limit, otherwise they'd be baked again every frame.
+		std::sort(baked.begin(), baked.end(), [](const Chunk* a, const Chunk* b) { return a->LastDrawnFrame < b->LastDrawnFrame; });
+		for (size_t i = 0; i < baked.size() - maxBakedCount && baked[i]->LastDrawnFrame < frame; ++i) { baked[i]->Baked = Texture(); }
+	}
+}
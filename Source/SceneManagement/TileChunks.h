@@ -0,0 +1,88 @@
+#pragma once
+#include "RenderList.h"
+#include "../Core/Texture.h"
+#include "../Maths/Vector2.h"
+#include "../Maths/Rectangle.h"
+#include <compare>
+#include <cstdint>
+#include <map>
+
+namespace Engine
+{
+	/// <summary>
+	/// Static tiles grouped into fixed size squares of world space per Z, so that each square can be drawn once into a
+	/// texture and then drawn as a single quad every frame rather than a sprite per tile.
+	/// </summary>
+	/// <remarks>
+	/// Only keeps track of which chunks there are and which need drawing again, the scene does the drawing. Chunks are
+	/// marked dirty from <see cref="RenderList::GetStaticChanges"/>, i.e. when tiles are created or deleted, including by
+	/// <see cref="CreateEntityCommand"/> and <see cref="DeleteEntityCommand"/> and their undos.
+	/// </remarks>
+	class TileChunks
+	{
+	public:
+		/// <summary>
+		/// Ordered the way chunks are drawn: by Z, then by row so those higher up the screen are behind, then by column.
+		/// </summary>
+		struct ChunkKey
+		{
+			int Z;
+			int Row;
+			int Column;
+
+			auto operator<=>(const ChunkKey&) const = default;
+		};
+
+		struct Chunk
+		{
+			Texture Baked; // Empty until first drawn, and after being evicted.
+			Rectangle<float> Bounds; // The world space area the baked texture covers.
+			bool IsDirty = true;
+			uint64_t LastDrawnFrame = 0;
+
+			bool IsBaked() const { return static_cast<SDL_Texture*>(Baked) != nullptr; }
+		};
+
+	private:
+		float ChunkSize;
+		std::map<ChunkKey, Chunk> Chunks;
+
+	public:
+		/// <param name="chunkSize">Width and height of a chunk in world space. Larger chunks take fewer draw calls but
+		/// more memory, and take longer to draw again when a tile in them changes.</param>
+		explicit TileChunks(float chunkSize);
+
+		ChunkKey GetKey(int z, Vector2<float> position) const;
+
+		/// <returns>The world space area whose tiles belong to the chunk. Their sprites can reach outside of it.</returns>
+		Rectangle<float> GetArea(ChunkKey key) const;
+
+		/// <summary>
+		/// Mark the chunk the position is in as needing drawing again, adding it if there isn't one.
+		/// </summary>
+		void Invalidate(int z, Vector2<float> position);
+
+		/// <summary>
+		/// Mark every chunk as needing drawing again, such as when the contents of their textures have been lost.
+		/// </summary>
+		void InvalidateAll();
+
+		/// <summary>
+		/// Invalidate everywhere static tiles changed since the render list's last update.
+		/// </summary>
+		void Update(const RenderList& renderList);
+
+		/// <summary>
+		/// Free the textures of the least recently drawn chunks until at most the given number are baked, so memory
+		/// doesn't grow with the size of the map. Evicted chunks are baked again if they come back into view.
+		/// </summary>
+		/// <param name="frame">The frame chunks drawn this frame were marked with, these are never evicted.</param>
+		void Evict(size_t maxBakedCount, uint64_t frame);
+
+		void Clear() { Chunks.clear(); }
+		size_t size() const { return Chunks.size(); }
+
+		std::map<ChunkKey, Chunk>& GetChunks() { return Chunks; }
+		const std::map<ChunkKey, Chunk>& GetChunks() const { return Chunks; }
+	};
+}
@@ -0,0 +1,87 @@
+#include "../../Source/Collision/SpatialHash.h"
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include "../../Source/EntityComponentSystem/Components.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	namespace
+	{
+		Entity AddAt(EntityManager& entityManager, float x, float y)
+		{
+			Entity entity = entityManager.AddEntity("Spatial");
+			Position& position = entity.AddComponent<Position>();
+			position.X = x;
+			position.Y = y;
+			return entity;
+		}
+
+		bool Contains(const std::vector<Entity>& entities, Entity entity)
+		{
+			return std::find(entities.begin(), entities.end(), entity) != entities.end();
+		}
+	}
+
+	TEST(SpatialHashTests, Queries)
+	{
+		EntityManager entityManager;
+		SpatialHash hash(10);
+		Entity origin = AddAt(entityManager, 0, 0);
+		Entity near = AddAt(entityManager, 3, 4);
+		Entity far = AddAt(entityManager, 100, 100);
+		Entity negative = AddAt(entityManager, -5, -5);
+		entityManager.Update();
+		hash.Update(entityManager);
+		ASSERT_EQ(hash.size(), 4);
+
+		std::vector<Entity> inRadius = hash.QueryRadius({ 0, 0 }, 5);
+		ASSERT_EQ(inRadius.size(), 2);
+		ASSERT_TRUE(Contains(inRadius, origin));
+		ASSERT_TRUE(Contains(inRadius, near));
+
+		std::vector<Entity> inRectangle = hash.QueryRectangle({ -10, -10, 12, 12 });
+		ASSERT_EQ(inRectangle.size(), 2);
+		ASSERT_TRUE(Contains(inRectangle, origin));
+		ASSERT_TRUE(Contains(inRectangle, negative));
+
+		// Spans far more cells than are occupied, so checks every occupied one.
+		ASSERT_EQ(hash.QueryRectangle({ -1000, -1000, 2000, 2000 }).size(), 4);
+
+		std::vector<Entity> inCell = hash.QueryPoint({ 9, 9 });
+		ASSERT_EQ(inCell.size(), 2);
+		ASSERT_TRUE(Contains(inCell, origin));
+		ASSERT_TRUE(Contains(inCell, near));
+		ASSERT_TRUE(hash.QueryPoint({ 50, 50 }).empty());
+		ASSERT_EQ(hash.QueryPoint({ 105, 105 })[0], far);
+	}
+
+	TEST(SpatialHashTests, TracksChanges)
+	{
+		EntityManager entityManager;
+		SpatialHash hash(10);
+		Entity moving = AddAt(entityManager, 0, 0);
+		Entity destroyed = AddAt(entityManager, 1, 1);
+		Entity removed = AddAt(entityManager, 2, 2);
+		entityManager.Update();
+		hash.Update(entityManager);
+
+		moving.GetComponent<Position>().X = 55;
+		entityManager.Destroy(destroyed);
+		removed.RemoveComponent<Position>();
+		Entity added = AddAt(entityManager, 3, 3);
+		entityManager.Update();
+		hash.Update(entityManager);
+
+		ASSERT_EQ(hash.size(), 2);
+		std::vector<Entity> nearOrigin = hash.QueryRadius({ 0, 0 }, 10);
+		ASSERT_EQ(nearOrigin.size(), 1);
+		ASSERT_EQ(nearOrigin[0], added);
+		ASSERT_EQ(hash.QueryPoint({ 55, 0 })[0], moving);
+
+		// Rebuilding with a different cell size keeps every entity.
+		hash.SetCellSize(100);
+		ASSERT_EQ(hash.size(), 2);
+		ASSERT_EQ(hash.QueryPoint({ 0, 0 }).size(), 2);
+	}
+}
@@ -0,0 +1,29 @@
+#include "../../Source/Core/NameTable.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	TEST(NameTableTests, InternsEachNameOnce)
+	{
+		NameTable<uint16_t> table;
+		ASSERT_EQ(table.Intern("First"), 0);
+		ASSERT_EQ(table.Intern("Second"), 1);
+		ASSERT_EQ(table.Intern(std::string("First")), 0);
+		ASSERT_EQ(table.GetName(1), "Second");
+		ASSERT_EQ(table.size(), 2);
+	}
+
+	TEST(NameTableTests, ThrowsWhenOutOfIDs)
+	{
+		NameTable<uint8_t> table;
+		for (int i = 0; i < 256; ++i) { table.Intern(std::to_string(i)); }
+		ASSERT_EQ(table.Intern("255"), 255);
+
+		// Wrapping round would hand out ID 0 again.
+		ASSERT_THROW(table.Intern("256"), std::length_error);
+		ASSERT_EQ(table.size(), 256);
+	}
+}
@@ -0,0 +1,82 @@
+#include "../../Source/Core/ThreadPool.h"
+#include <gtest/gtest.h>
+#include <numeric>
+
+namespace Engine
+{
+	TEST(ThreadPoolTests, ParallelForCoversRange)
+	{
+		ThreadPool pool;
+		pool.Start();
+
+		std::vector<int> visits(10000, 0);
+		pool.ParallelFor(0, visits.size(), 64, [&visits](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i) { ++visits[i]; }
+		});
+
+		pool.Stop();
+		ASSERT_TRUE(std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }));
+	}
+
+	TEST(ThreadPoolTests, GroupWaitsOnNestedJobs)
+	{
+		ThreadPool pool;
+		pool.Start();
+
+		// Jobs queued from inside jobs go on the worker's own deque, and still count towards the group.
+		TaskGroup group;
+		std::atomic<int> count = 0;
+		for (int i = 0; i < 64; ++i)
+		{
+			pool.QueueJob([&pool, &group, &count]()
+			{
+				for (int j = 0; j < 64; ++j)
+				{
+					pool.QueueJob([&count]() { ++count; }, &group);
+				}
+			}, &group);
+		}
+		pool.Wait(group);
+
+		ASSERT_EQ(count, 64 * 64);
+		ASSERT_TRUE(group.IsDone());
+
+		pool.WaitForAll();
+		ASSERT_FALSE(pool.Busy());
+		pool.Stop();
+	}
+
+	TEST(ThreadPoolTests, OverflowingDequeRunsJobs)
+	{
+		ThreadPool pool;
+		pool.Start();
+
+		TaskGroup group;
+		std::atomic<int> count = 0;
+		pool.QueueJob([&pool, &group, &count]()
+		{
+			for (int i = 0; i < WorkStealingDeque::CAPACITY * 4; ++i)
+			{
+				pool.QueueJob([&count]() { ++count; }, &group);
+			}
+		}, &group);
+		pool.Wait(group);
+		pool.Stop();
+
+		ASSERT_EQ(count, WorkStealingDeque::CAPACITY * 4);
+	}
+
+	TEST(ThreadPoolTests, JobDestroysCapture)
+	{
+		std::shared_ptr<int> shared = std::make_shared<int>(1);
+		{
+			Job job([shared]() { ++*shared; });
+			Job moved = std::move(job);
+			moved();
+			ASSERT_EQ(shared.use_count(), 2);
+		}
+		ASSERT_EQ(*shared, 2);
+		ASSERT_EQ(shared.use_count(), 1);
+	}
+}
@@ -0,0 +1,403 @@
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include "../../Source/EntityComponentSystem/Components.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	TEST(EntityManagerTests, ViewContainsMatchingEntities)
+	{
+		EntityManager entityManager;
+
+		Entity moving = entityManager.AddEntity("View");
+		moving.AddComponent<Position>();
+		moving.AddComponent<Velocity>();
+
+		Entity stationary = entityManager.AddEntity("View");
+		stationary.AddComponent<Position>();
+
+		entityManager.Update();
+
+		EntityView view = entityManager.GetView<Position, Velocity>();
+		ASSERT_EQ(view.size(), 1);
+		ASSERT_EQ(view[0], moving);
+		ASSERT_EQ((entityManager.GetView<Position>().size()), 2);
+	}
+
+	TEST(EntityManagerTests, ViewDefersAddingUntilUpdate)
+	{
+		EntityManager entityManager;
+		ASSERT_EQ((entityManager.GetView<Position, Velocity>().size()), 0);
+
+		Entity entity = entityManager.AddEntity("View");
+		entity.AddComponent<Position>();
+		entity.AddComponent<Velocity>();
+		ASSERT_EQ((entityManager.GetView<Position, Velocity>().size()), 0);
+
+		entityManager.Update();
+		ASSERT_EQ((entityManager.GetView<Position, Velocity>().size()), 1);
+	}
+
+	TEST(EntityManagerTests, ViewRemovesEntities)
+	{
+		EntityManager entityManager;
+
+		Entity removed = entityManager.AddEntity("View");
+		removed.AddComponent<Position>();
+		removed.AddComponent<Velocity>();
+
+		Entity destroyed = entityManager.AddEntity("View");
+		destroyed.AddComponent<Position>();
+		destroyed.AddComponent<Velocity>();
+
+		Entity kept = entityManager.AddEntity("View");
+		kept.AddComponent<Position>();
+		kept.AddComponent<Velocity>();
+
+		entityManager.Update();
+		ASSERT_EQ((entityManager.GetView<Position, Velocity>().size()), 3);
+
+		removed.RemoveComponent<Velocity>();
+		entityManager.Update();
+		entityManager.Destroy(destroyed);
+		entityManager.Update();
+
+		EntityView view = entityManager.GetView<Position, Velocity>();
+		ASSERT_EQ(view.size(), 1);
+		ASSERT_EQ(view[0], kept);
+	}
+
+	TEST(EntityManagerTests, ViewTracksEnabledComponents)
+	{
+		EntityManager entityManager;
+
+		Entity entity = entityManager.AddEntity("View");
+		entity.AddComponent<Position>();
+		entityManager.Update();
+		ASSERT_EQ((entityManager.GetView<Position, Sprite>().size()), 0);
+
+		// The editor enables components directly through the bitset.
+		entityManager.GetEnabledComponents(entity.GetID())[tuple_element_index_v<Sprite, ComponentSlice>] = true;
+		entityManager.Update();
+		ASSERT_EQ((entityManager.GetView<Position, Sprite>().size()), 1);
+	}
+
+	TEST(EntityManagerTests, SparseComponentOnlyStoredWhenAdded)
+	{
+		EntityManager entityManager;
+		SparseStorage<Collider>& colliders = EntityMemoryPool::Instance().GetStorage<Collider>();
+		const size_t initialSize = colliders.size();
+
+		Entity tile = entityManager.AddEntity("Sparse");
+		tile.AddComponent<Position>();
+
+		Entity wall = entityManager.AddEntity("Sparse");
+		wall.AddComponent<Position>();
+		wall.AddComponent<Collider>().NumberOfPoints = 2;
+
+		ASSERT_EQ(colliders.size(), initialSize + 1);
+		ASSERT_FALSE(colliders.Contains(tile.GetID()));
+		ASSERT_EQ(wall.GetComponent<Collider>().NumberOfPoints, 2);
+
+		// Slices of entities without the component get a default rather than storing one.
+		ComponentSlice slice = entityManager.GetPoolSlice(tile.GetID());
+		ASSERT_EQ(std::get<Collider>(slice).NumberOfPoints, 0);
+		ASSERT_EQ(tile.ReadComponent<Collider>().NumberOfPoints, 0);
+		ComponentReferenceSlice references = entityManager.GetReferenceSlice(tile.GetID());
+		ASSERT_EQ(std::get<Collider&>(references).NumberOfPoints, 0);
+		ASSERT_EQ(colliders.size(), initialSize + 1);
+		ASSERT_FALSE(colliders.Contains(tile.GetID()));
+
+		entityManager.Update();
+		entityManager.Destroy(wall);
+		entityManager.Update();
+		ASSERT_EQ(colliders.size(), initialSize);
+	}
+
+	TEST(EntityManagerTests, SparseComponentSurvivesRemovalOfOthers)
+	{
+		EntityManager entityManager;
+
+		std::vector<Entity> walls;
+		for (int i = 0; i < 4; ++i)
+		{
+			Entity wall = entityManager.AddEntity("Sparse");
+			wall.AddComponent<Collider>().NumberOfPoints = i;
+			walls.push_back(wall);
+		}
+
+		walls[1].RemoveComponent<Collider>();
+		entityManager.Update();
+		entityManager.Destroy(walls[0]);
+
+		ASSERT_EQ(walls[2].GetComponent<Collider>().NumberOfPoints, 2);
+		ASSERT_EQ(walls[3].GetComponent<Collider>().NumberOfPoints, 3);
+	}
+
+	TEST(EntityManagerTests, StaleHandleDetected)
+	{
+		EntityManager entityManager;
+
+		Entity destroyed = entityManager.AddEntity("Generation");
+		entityManager.Update();
+		entityManager.Destroy(destroyed);
+		ASSERT_FALSE(destroyed.IsAlive());
+
+		// The destroyed ID is reused next, but the old handle shouldn't refer to the new entity.
+		Entity reused = entityManager.AddEntity("Generation");
+		entityManager.Update();
+		ASSERT_EQ(reused.GetID(), destroyed.GetID());
+		ASSERT_NE(reused, destroyed);
+		ASSERT_TRUE(reused.IsAlive());
+		ASSERT_FALSE(destroyed.IsAlive());
+
+		// Destroying through a stale handle leaves the new entity alone.
+		entityManager.Destroy(destroyed);
+		ASSERT_TRUE(reused.IsAlive());
+		ASSERT_EQ(entityManager.GetEntities().size(), 1);
+	}
+
+	TEST(EntityManagerTests, PoolGrowsWithoutMovingComponents)
+	{
+		EntityManager entityManager;
+		EntityMemoryPool& pool = EntityMemoryPool::Instance();
+
+		Entity first = entityManager.AddEntity("Growth");
+		Position& position = first.AddComponent<Position>();
+		position.X = 5;
+
+		// Use up every remaining ID so that the pool has to grow.
+		const size_t initialCapacity = pool.GetCapacity();
+		const size_t toAdd = initialCapacity - pool.GetEntityAliveCount() + 1;
+		for (size_t i = 0; i < toAdd; ++i)
+		{
+			entityManager.AddEntity("Growth").AddComponent<Position>();
+		}
+		entityManager.Update();
+
+		ASSERT_GT(pool.GetCapacity(), initialCapacity);
+		ASSERT_EQ(&position, &first.GetComponent<Position>());
+		ASSERT_EQ(position.X, 5);
+		ASSERT_EQ((entityManager.GetView<Position>().size()), toAdd + 1);
+	}
+
+	TEST(EntityManagerTests, SaveAndLoadRoundTrip)
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "EntityManagerTests.scene").string();
+
+		{
+			EntityManager entityManager;
+			Entity tile = entityManager.AddEntity("Tile");
+			tile.AddComponent<Position>().X = 10;
+			Collider& collider = tile.AddComponent<Collider>();
+			collider.NumberOfPoints = 1;
+			collider.Points[0] = { 3, 4 };
+			tile.AddComponent<Sprite>().Texture = TextureRegistry::Instance().GetId("SaveAndLoadRoundTrip.png");
+
+			// Newlines inside component bytes used to split entities apart.
+			Entity player = entityManager.AddEntity("Player");
+			player.AddComponent<Position>().X = 0x0A0A;
+			entityManager.Update();
+
+			ASSERT_TRUE(entityManager.Save(path));
+		}
+
+		EntityManager entityManager;
+		ASSERT_TRUE(entityManager.Load(path));
+		entityManager.Update();
+
+		ASSERT_EQ(entityManager.GetEntities().size(), 2);
+		Entity tile = entityManager.GetEntitiesByTag("Tile")[0];
+		ASSERT_EQ(tile.GetComponent<Position>().X, 10);
+		ASSERT_TRUE(tile.HasComponent<Collider>());
+		ASSERT_EQ(tile.GetComponent<Collider>().Points[0], (Vector2<float>{ 3, 4 }));
+		ASSERT_EQ(TextureRegistry::Instance().GetName(tile.GetComponent<Sprite>().Texture), "SaveAndLoadRoundTrip.png");
+
+		Entity player = entityManager.GetEntitiesByTag("Player")[0];
+		ASSERT_EQ(player.GetComponent<Position>().X, 0x0A0A);
+		ASSERT_FALSE(player.HasComponent<Collider>());
+		ASSERT_EQ((entityManager.GetView<Position, Collider>().size()), 1);
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(EntityManagerTests, LoadCopiesComponentsAcrossChunks)
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "EntityManagerTests.chunks.scene").string();
+		constexpr size_t entityCount = ChunkedVector<Position>::CHUNK_SIZE * 2 + 1;
+
+		{
+			EntityManager entityManager;
+			for (size_t i = 0; i < entityCount; ++i)
+			{
+				Entity entity = entityManager.AddEntity("Chunked");
+				entity.AddComponent<Position>().X = static_cast<float>(i);
+				if (i % 3 != 0) { entity.AddComponent<Velocity>().Speed = static_cast<float>(i); }
+			}
+			entityManager.Update();
+			ASSERT_TRUE(entityManager.Save(path));
+		}
+
+		EntityManager entityManager;
+		const uint32_t loaded = EntityMemoryPool::Instance().GetTick();
+		ASSERT_TRUE(entityManager.Load(path));
+		entityManager.Update();
+
+		ASSERT_EQ(entityManager.GetEntities().size(), entityCount);
+		size_t changedCount = 0;
+		for ([[maybe_unused]] Entity entity : entityManager.GetView<Changed<Position>>(loaded)) { ++changedCount; }
+		ASSERT_EQ(changedCount, entityCount);
+		size_t velocityCount = 0;
+		for (Entity entity : entityManager.GetEntities())
+		{
+			const float x = entity.ReadComponent<Position>().X;
+			ASSERT_EQ(entity.HasComponent<Velocity>(), static_cast<size_t>(x) % 3 != 0);
+			if (entity.HasComponent<Velocity>())
+			{
+				ASSERT_EQ(entity.ReadComponent<Velocity>().Speed, x);
+				++velocityCount;
+			}
+		}
+		ASSERT_EQ(velocityCount, entityCount - (entityCount + 2) / 3);
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(EntityManagerTests, LoadRejectsInvalidFile)
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "EntityManagerTests.invalid").string();
+		std::ofstream{ path } << "Not a scene";
+
+		EntityManager entityManager;
+		entityManager.AddEntity("Existing");
+		entityManager.Update();
+
+		ASSERT_FALSE(entityManager.Load(path));
+		ASSERT_FALSE(entityManager.Load(path + ".missing"));
+		ASSERT_EQ(entityManager.GetEntities().size(), 1);
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(EntityManagerTests, TagsAreInterned)
+	{
+		EntityManager entityManager;
+
+		Entity player = entityManager.AddEntity(Tags::Player);
+		Entity interned = entityManager.AddEntity("Interned");
+		Entity internedAgain = entityManager.AddEntity(std::string("Interned"));
+
+		ASSERT_EQ(player.GetTag(), Tags::Player);
+		ASSERT_EQ(player.GetTagName(), "Player");
+		ASSERT_EQ(interned.GetTag(), internedAgain.GetTag());
+		ASSERT_EQ(TagTable::Instance().Intern("Player"), Tags::Player);
+
+		ASSERT_EQ(entityManager.GetEntitiesByTag(Tags::Player).size(), 1);
+		ASSERT_EQ(entityManager.GetEntitiesByTag("Interned").size(), 2);
+
+		entityManager.Destroy(interned);
+		entityManager.Update();
+		ASSERT_EQ(entityManager.GetEntitiesByTag(internedAgain.GetTag()).size(), 1);
+	}
+
+	TEST(EntityManagerTests, DestroyDefersRemoval)
+	{
+		EntityManager entityManager;
+		for (int i = 0; i < 100; ++i)
+		{
+			entityManager.AddEntity("Destroy").AddComponent<Position>();
+		}
+		entityManager.Update();
+
+		// Destroying everything while iterating is safe, as nothing is removed until Update.
+		for (Entity entity : entityManager.GetView<Position>())
+		{
+			entityManager.Destroy(entity);
+		}
+		ASSERT_EQ(entityManager.GetEntities().size(), 100);
+		ASSERT_EQ((entityManager.GetView<Position>().size()), 100);
+
+		entityManager.Update();
+		ASSERT_EQ(entityManager.GetEntities().size(), 0);
+		ASSERT_EQ(entityManager.GetEntitiesByTag("Destroy").size(), 0);
+		ASSERT_EQ((entityManager.GetView<Position>().size()), 0);
+	}
+
+	TEST(EntityManagerTests, DestroyedIDReusedBeforeUpdate)
+	{
+		EntityManager entityManager;
+		Entity kept = entityManager.AddEntity("Kept");
+		Entity destroyed = entityManager.AddEntity("Destroyed");
+		entityManager.Update();
+
+		// The ID is released straight away, so it's reused by the next entity before the destroyed one is removed.
+		entityManager.Destroy(destroyed);
+		Entity reused = entityManager.AddEntity("Reused");
+		ASSERT_EQ(reused.GetID(), destroyed.GetID());
+		entityManager.Update();
+
+		ASSERT_EQ(entityManager.GetEntities().size(), 2);
+		ASSERT_EQ(entityManager.GetEntitiesByTag("Destroyed").size(), 0);
+		ASSERT_EQ(entityManager.GetEntitiesByTag("Reused")[0], reused);
+		ASSERT_NE(std::find(entityManager.GetEntities().begin(), entityManager.GetEntities().end(), kept), entityManager.GetEntities().end());
+	}
+
+	TEST(EntityManagerTests, ComponentsStampedWhenChanged)
+	{
+		EntityManager entityManager;
+		Entity entity = entityManager.AddEntity("Changed");
+		entity.AddComponent<Position>();
+		entity.AddComponent<Velocity>();
+		entityManager.Update();
+		const uint32_t tick = EntityMemoryPool::Instance().GetTick();
+
+		// Reading doesn't count as a change, but mutable access and marking do.
+		entity.ReadComponent<Position>();
+		ASSERT_LT(entity.GetChangedTick<Position>(), tick);
+
+		entity.GetComponent<Position>().X = 1;
+		ASSERT_EQ(entity.GetChangedTick<Position>(), tick);
+
+		entity.MarkChanged<Velocity>();
+		ASSERT_EQ(entity.GetChangedTick<Velocity>(), tick);
+	}
+
+	TEST(EntityManagerTests, ChangedViewSkipsUnchangedEntities)
+	{
+		EntityManager entityManager;
+		const uint32_t added = EntityMemoryPool::Instance().GetTick();
+		std::vector<Entity> entities;
+		for (int i = 0; i < 10; ++i)
+		{
+			Entity entity = entityManager.AddEntity("Changed");
+			entity.AddComponent<Position>();
+			entity.AddComponent<Sprite>();
+			entities.push_back(entity);
+		}
+		entityManager.Update();
+		entityManager.Update();
+		ASSERT_TRUE((entityManager.GetView<Changed<Position>, Sprite>().empty()));
+
+		entities[3].GetComponent<Position>().X = 3;
+		entities[7].GetComponent<Position>().X = 7;
+		entities[5].GetComponent<Sprite>().PivotOffset.X = 5;
+
+		std::vector<Entity> changed;
+		for (Entity entity : entityManager.GetView<Changed<Position>, Sprite>())
+		{
+			changed.push_back(entity);
+		}
+		ASSERT_EQ(changed.size(), 2);
+		ASSERT_NE(std::find(changed.begin(), changed.end(), entities[3]), changed.end());
+		ASSERT_NE(std::find(changed.begin(), changed.end(), entities[7]), changed.end());
+
+		// Changes from earlier ticks can still be found by passing the tick to look from.
+		entityManager.Update();
+		ASSERT_TRUE((entityManager.GetView<Changed<Position>, Sprite>().empty()));
+		size_t count = 0;
+		for ([[maybe_unused]] Entity entity : entityManager.GetView<Changed<Position>, Changed<Sprite>>(added)) { ++count; }
+		ASSERT_EQ(count, 10); // Adding counts as a change.
+	}
+}
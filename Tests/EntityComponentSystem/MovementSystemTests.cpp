@@ -0,0 +1,52 @@
+#include "../../Source/EntityComponentSystem/Systems/MovementSystem.h"
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include "../../Source/EntityComponentSystem/Components.h"
+#include "../../Source/SceneManagement/BaseScene.h"
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	/// <summary>
+	/// A scene with nothing to draw, only here to own the entities.
+	/// </summary>
+	class MovementTestScene : public BaseScene
+	{
+	public:
+		MovementTestScene() : BaseScene(0) {}
+		void Render(Renderer& /*renderer*/) override {}
+	};
+
+	TEST(MovementSystemTests, IdleEntitiesNotMarkedChanged)
+	{
+		MovementTestScene scene;
+		EntityManager& entityManager = scene.GetEntityManager();
+		MovementSystem system(scene);
+
+		Entity stopped = entityManager.AddEntity("Movement");
+		stopped.AddComponent<Position>();
+		stopped.AddComponent<Velocity>() = { 0, { 1, 0 } };
+
+		Entity directionless = entityManager.AddEntity("Movement");
+		directionless.AddComponent<Position>();
+		directionless.AddComponent<Velocity>() = { 10, { 0, 0 } };
+
+		Entity moving = entityManager.AddEntity("Movement");
+		moving.AddComponent<Position>();
+		moving.AddComponent<Velocity>() = { 10, { 1, 0 } };
+
+		// Being added counts as a change, so only the update after shows what movement changed.
+		entityManager.Update();
+		system.Update(1);
+		entityManager.Update();
+		system.Update(1);
+
+		std::vector<Entity> changed;
+		for (Entity entity : entityManager.GetView<Changed<Position>>()) { changed.push_back(entity); }
+		ASSERT_EQ(changed.size(), 1);
+		ASSERT_EQ(changed[0], moving);
+		ASSERT_EQ(moving.ReadComponent<Position>().X, 20);
+		ASSERT_EQ(stopped.ReadComponent<Position>().X, 0);
+	}
+}
@@ -0,0 +1,182 @@
+#include "../../Source/EntityComponentSystem/Systems/SystemScheduler.h"
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include "../../Source/EntityComponentSystem/Components.h"
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	/// <summary>
+	/// Moves every entity to X = 1.
+	/// </summary>
+	class SetPositionSystem : public BaseSystem
+	{
+		EntityManager& Manager;
+
+	public:
+		SetPositionSystem(EntityManager& manager) : Manager(manager) {}
+
+		void Update(const float& deltaTime) override { UpdateRange(deltaTime, 0, GetWorkSize()); }
+		SystemAccess GetAccess() const override { return SystemAccess().Write<Position>(); }
+		size_t GetWorkSize() override { return Manager.GetView<Position, Velocity>().size(); }
+
+		void UpdateRange(const float& /*deltaTime*/, size_t begin, size_t end) override
+		{
+			EntityView view = Manager.GetView<Position, Velocity>();
+			for (size_t i = begin; i < end; ++i)
+			{
+				view[i].GetComponent<Position>().X = 1;
+			}
+		}
+	};
+
+	/// <summary>
+	/// Copies position into speed, so it's only correct if it runs after <see cref="SetPositionSystem"/>.
+	/// </summary>
+	class CopyPositionSystem : public BaseSystem
+	{
+		EntityManager& Manager;
+
+	public:
+		CopyPositionSystem(EntityManager& manager) : Manager(manager) {}
+
+		void Update(const float& deltaTime) override { UpdateRange(deltaTime, 0, GetWorkSize()); }
+		SystemAccess GetAccess() const override { return SystemAccess().Read<Position>().Write<Velocity>(); }
+		size_t GetWorkSize() override { return Manager.GetView<Position, Velocity>().size(); }
+
+		void UpdateRange(const float& /*deltaTime*/, size_t begin, size_t end) override
+		{
+			EntityView view = Manager.GetView<Position, Velocity>();
+			for (size_t i = begin; i < end; ++i)
+			{
+				view[i].GetComponent<Velocity>().Speed = view[i].GetComponent<Position>().X;
+			}
+		}
+	};
+
+	/// <summary>
+	/// Doesn't declare any access or work size, so must run on its own and unsplit.
+	/// </summary>
+	class CountingSystem : public BaseSystem
+	{
+	public:
+		int Count = 0;
+		void Update(const float& /*deltaTime*/) override { ++Count; }
+	};
+
+	/// <summary>
+	/// Replaces every entity with a new one that remembers the old position, through the command buffer.
+	/// </summary>
+	class RespawnSystem : public BaseSystem
+	{
+		EntityManager& Manager;
+
+	public:
+		RespawnSystem(EntityManager& manager) : Manager(manager) {}
+
+		void Update(const float& deltaTime) override { UpdateRange(deltaTime, 0, GetWorkSize()); }
+		SystemAccess GetAccess() const override { return SystemAccess().Read<Position>(); }
+		size_t GetWorkSize() override { return Manager.GetView<Position>().size(); }
+
+		void UpdateRange(const float& /*deltaTime*/, size_t begin, size_t end) override
+		{
+			EntityCommandBuffer& commands = EntityCommandBuffer::GetCurrent();
+			EntityView view = Manager.GetView<Position>();
+			for (size_t i = begin; i < end; ++i)
+			{
+				Entity entity = view[i];
+				EntityCommandBuffer::PendingEntity respawned = commands.Create("Respawned");
+				commands.AddComponent<Position>(respawned, entity.GetComponent<Position>());
+				commands.Destroy(entity);
+			}
+		}
+	};
+
+	TEST(SystemSchedulerTests, ConflictingSystemsRunInOrder)
+	{
+		EntityManager entityManager;
+		constexpr size_t entityCount = SystemScheduler::MINIMUM_CHUNK_SIZE * 8 + 1; // Enough to be split into chunks.
+		for (size_t i = 0; i < entityCount; ++i)
+		{
+			Entity entity = entityManager.AddEntity("Scheduler");
+			entity.AddComponent<Position>();
+			entity.AddComponent<Velocity>();
+		}
+		entityManager.Update();
+
+		std::vector<std::unique_ptr<BaseSystem>> systems;
+		systems.emplace_back(std::make_unique<SetPositionSystem>(entityManager));
+		systems.emplace_back(std::make_unique<CopyPositionSystem>(entityManager));
+		systems.emplace_back(std::make_unique<CountingSystem>());
+
+		ThreadPool pool;
+		pool.Start();
+		SystemScheduler scheduler(pool);
+		scheduler.Run(systems, 0);
+		scheduler.Run(systems, 0);
+		pool.Stop();
+
+		// Every chunk of every system has finished by the time Run returns.
+		for (Entity entity : entityManager.GetView<Position, Velocity>())
+		{
+			ASSERT_EQ(entity.GetComponent<Velocity>().Speed, 1);
+		}
+		ASSERT_EQ(static_cast<CountingSystem&>(*systems[2]).Count, 2);
+	}
+
+	TEST(SystemSchedulerTests, AccessConflicts)
+	{
+		const SystemAccess readPosition = SystemAccess().Read<Position>();
+		const SystemAccess writePosition = SystemAccess().Write<Position>();
+		const SystemAccess writeVelocity = SystemAccess().Write<Velocity>();
+
+		ASSERT_FALSE(readPosition.ConflictsWith(readPosition));
+		ASSERT_TRUE(readPosition.ConflictsWith(writePosition));
+		ASSERT_TRUE(writePosition.ConflictsWith(readPosition));
+		ASSERT_TRUE(writePosition.ConflictsWith(writePosition));
+		ASSERT_FALSE(writePosition.ConflictsWith(writeVelocity));
+		ASSERT_TRUE(SystemAccess::Exclusive().ConflictsWith(readPosition));
+	}
+
+	TEST(SystemSchedulerTests, CommandsPlayedBackInOrder)
+	{
+		EntityManager entityManager;
+		constexpr size_t entityCount = SystemScheduler::MINIMUM_CHUNK_SIZE * 8 + 1;
+		for (size_t i = 0; i < entityCount; ++i)
+		{
+			entityManager.AddEntity("Respawn").AddComponent<Position>().X = static_cast<float>(i);
+		}
+		entityManager.Update();
+
+		// IDs are reused in any order, so the view isn't necessarily in creation order.
+		std::vector<float> expected;
+		for (Entity entity : entityManager.GetView<Position>())
+		{
+			expected.push_back(entity.GetComponent<Position>().X);
+		}
+
+		std::vector<std::unique_ptr<BaseSystem>> systems;
+		systems.emplace_back(std::make_unique<RespawnSystem>(entityManager));
+
+		ThreadPool pool;
+		pool.Start();
+		SystemScheduler scheduler(pool);
+		scheduler.Run(systems, 0);
+		pool.Stop();
+
+		// Nothing changes until playback.
+		ASSERT_EQ(entityManager.GetEntitiesByTag("Respawn").size(), entityCount);
+		ASSERT_EQ(entityManager.GetEntitiesByTag("Respawned").size(), 0);
+
+		scheduler.PlaybackCommands(entityManager);
+		entityManager.Update();
+
+		// Created in the same order as the entities they replaced were iterated, however the chunks were split between threads.
+		ASSERT_EQ(entityManager.GetEntitiesByTag("Respawn").size(), 0);
+		std::vector<Entity>& respawned = entityManager.GetEntitiesByTag("Respawned");
+		ASSERT_EQ(respawned.size(), entityCount);
+		for (size_t i = 0; i < entityCount; ++i)
+		{
+			ASSERT_EQ(respawned[i].GetComponent<Position>().X, expected[i]);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#include "../../Source/Maths/RadixSort.h"
+#include <random>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	namespace
+	{
+		std::vector<uint64_t> GetRandomKeys(size_t count, uint64_t mask)
+		{
+			std::mt19937_64 random(count);
+			std::vector<uint64_t> keys(count);
+			for (uint64_t& key : keys) { key = random() & mask; }
+			return keys;
+		}
+	}
+
+	TEST(RadixSortTests, MatchesComparisonSort)
+	{
+		for (uint64_t mask : { ~uint64_t(0), uint64_t(0xFF00FF), uint64_t(0xFFFF000000000000) })
+		{
+			std::vector<uint64_t> keys = GetRandomKeys(1000, mask);
+			std::vector<uint64_t> expected = keys;
+			std::sort(expected.begin(), expected.end());
+			RadixSort(keys);
+			ASSERT_EQ(keys, expected);
+		}
+
+		std::vector<uint64_t> same(10, 42);
+		RadixSort(same);
+		ASSERT_EQ(same, std::vector<uint64_t>(10, 42));
+	}
+
+	TEST(RadixSortTests, SortsLargeInputsInParallel)
+	{
+		std::vector<uint64_t> keys = GetRandomKeys(ParallelRadixSortThreshold * 2 + 7, ~uint64_t(0));
+		std::vector<uint64_t> expected = keys;
+		std::sort(expected.begin(), expected.end());
+
+		std::vector<uint64_t> buffer;
+		RadixSort(keys, buffer);
+		ASSERT_EQ(keys, expected);
+	}
+}
@@ -0,0 +1,99 @@
+#include "../../Source/Pathfinding/FlowField.h"
+#include "../../Source/Pathfinding/GridPathfinder.h"
+#include "../../Source/Pathfinding/WalkabilityGrid.h"
+#include <random>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	TEST(FlowFieldTests, LeadsToGoal)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 16, 16 }, WalkabilityGrid::AllDirections);
+		for (int y = 0; y < 15; ++y)
+		{
+			grid.BlockCell({ 8, y });
+		}
+		grid.BlockCell({ 2, 2 });
+
+		FlowField field;
+		field.Build(grid, { 12, 3 });
+		ASSERT_EQ(field.GetGoal(), (Vector2<int>{ 12, 3 }));
+		ASSERT_EQ(field.GetReachedCount(), 16 * 16 - 16); // All but the blocked cells.
+		ASSERT_EQ(field.GetDistance({ 12, 3 }), 0);
+		ASSERT_FALSE(field.GetNext({ 12, 3 }).has_value());
+
+		// Around the bottom of the wall.
+		Vector2<int> cell = { 1, 1 };
+		const int distance = *field.GetDistance(cell);
+		for (int step = 0; step < distance; ++step)
+		{
+			const std::optional<Vector2<int>> next = field.GetNext(cell);
+			ASSERT_TRUE(next.has_value());
+			ASSERT_TRUE(grid.CanMove(cell, WalkabilityGrid::GetDirectionIndex(*next - cell)));
+			ASSERT_EQ(field.GetDistance(*next), distance - step - 1);
+			cell = *next;
+		}
+		ASSERT_EQ(cell, (Vector2<int>{ 12, 3 }));
+
+		ASSERT_FALSE(field.GetDistance({ 2, 2 }).has_value()); // Blocked.
+		ASSERT_FALSE(field.GetNext({ 2, 2 }).has_value());
+		ASSERT_FALSE(field.GetDistance({ 20, 3 }).has_value()); // Outside the grid.
+		ASSERT_FALSE(field.GetNext({ -1, 3 }).has_value());
+	}
+
+	TEST(FlowFieldTests, GoesAroundCostlyTerrain)
+	{
+		// A cheap way round a strip of mud takes as many moves as wading straight through.
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 9, 5 }, WalkabilityGrid::AllDirections);
+		for (int y = 0; y < 4; ++y)
+		{
+			grid.SetCost({ 4, y }, 10);
+		}
+
+		FlowField field;
+		field.Build(grid, { 8, 0 });
+		ASSERT_EQ(field.GetDistance({ 0, 0 }), 8);
+
+		Vector2<int> cell = { 0, 0 };
+		while (cell != field.GetGoal())
+		{
+			ASSERT_EQ(grid.GetCost(cell), WalkabilityGrid::DefaultCost);
+			cell = *field.GetNext(cell);
+		}
+	}
+
+	TEST(FlowFieldTests, MatchesAStarDistances)
+	{
+		std::mt19937 random(4321);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+
+		for (int test = 0; test < 20; ++test)
+		{
+			WalkabilityGrid grid;
+			grid.Resize({ 0, 0 }, { 32, 32 }, WalkabilityGrid::AllDirections);
+			for (size_t i = 0; i < grid.GetCellCount(); ++i)
+			{
+				if (random() % 100 < 25) { grid.BlockCell(grid.GetCell(i)); }
+				else if (test % 2 && random() % 100 < 25) { grid.SetCost(grid.GetCell(i), static_cast<uint8_t>(random() % 256)); }
+			}
+
+			FlowField field;
+			const Vector2<int> goal = grid.GetCell(random() % grid.GetCellCount());
+			field.Build(grid, goal);
+			for (int sample = 0; sample < 20; ++sample)
+			{
+				const Vector2<int> start = grid.GetCell(random() % grid.GetCellCount());
+				const bool isFound = pathfinder.AStar(grid, start, goal, path);
+				ASSERT_EQ(field.GetDistance(start).has_value(), isFound);
+				if (!isFound) { continue; }
+
+				int cost = 0;
+				for (size_t i = 1; i < path.size(); ++i) { cost += grid.GetCost(path[i]); }
+				ASSERT_EQ(*field.GetDistance(start), cost);
+			}
+		}
+	}
+}
@@ -0,0 +1,196 @@
+#include "../../Source/Pathfinding/GridPathfinder.h"
+#include "../../Source/Pathfinding/WalkabilityGrid.h"
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	TEST(GridPathfinderTests, FindsShortestPath)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 10, 10 }, WalkabilityGrid::AllDirections);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+
+		ASSERT_TRUE(pathfinder.AStar(grid, { 0, 0 }, { 5, 3 }, path));
+		ASSERT_EQ(path.size(), 6); // Diagonal moves cost the same, so it's the larger difference plus the start.
+		ASSERT_EQ(path.front(), (Vector2<int>{ 0, 0 }));
+		ASSERT_EQ(path.back(), (Vector2<int>{ 5, 3 }));
+
+		ASSERT_TRUE(pathfinder.AStar(grid, { 4, 4 }, { 4, 4 }, path));
+		ASSERT_EQ(path.size(), 1);
+	}
+
+	TEST(GridPathfinderTests, AvoidsBlockedCells)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 10, 10 }, WalkabilityGrid::AllDirections);
+		for (int y = 0; y < 9; ++y) { grid.SetMask({ 5, y }, 0); }
+		for (size_t i = 0; i < grid.GetCellCount(); ++i)
+		{
+			// Nothing can step into the wall either.
+			const Vector2<int> cell = grid.GetCell(i);
+			for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
+			{
+				const Vector2<int> neighbour = cell + WalkabilityGrid::Directions[direction];
+				if (neighbour.X == 5 && neighbour.Y < 9) { grid.SetMask(cell, grid.GetMask(cell) & ~(1u << direction)); }
+			}
+		}
+
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+		ASSERT_TRUE(pathfinder.AStar(grid, { 0, 0 }, { 9, 0 }, path));
+		for (const Vector2<int>& cell : path) { ASSERT_FALSE(cell.X == 5 && cell.Y < 9); }
+		ASSERT_EQ(path.size(), 19); // Down to the gap and back up.
+
+		// Repeated searches reuse the nodes from the last one without being affected by them.
+		std::vector<Vector2<int>> repeated;
+		ASSERT_TRUE(pathfinder.AStar(grid, { 0, 0 }, { 9, 0 }, repeated));
+		ASSERT_EQ(repeated.size(), path.size());
+	}
+
+	TEST(GridPathfinderTests, NoPath)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 10, 10 }, WalkabilityGrid::AllDirections);
+		for (size_t i = 0; i < grid.GetCellCount(); ++i)
+		{
+			if (grid.GetCell(i).X >= 5) { grid.SetMask(grid.GetCell(i), 0); }
+			else if (grid.GetCell(i).X == 4) { grid.SetMask(grid.GetCell(i), 0b01111100); } // Only directions that don't move right.
+		}
+
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+		ASSERT_FALSE(pathfinder.AStar(grid, { 0, 0 }, { 9, 9 }, path));
+		ASSERT_TRUE(path.empty());
+		ASSERT_FALSE(pathfinder.AStar(grid, { 0, 0 }, { 20, 0 }, path)); // Outside the grid.
+	}
+
+	TEST(GridPathfinderTests, JumpPointSearchMatchesAStar)
+	{
+		std::mt19937 random(1234);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> aStarPath;
+		std::vector<Vector2<int>> jumpPointPath;
+
+		for (int test = 0; test < 50; ++test)
+		{
+			// Block random cells, and a few random single edges as colliders can block some directions but not others.
+			WalkabilityGrid grid;
+			grid.Resize({ 0, 0 }, { 32, 32 }, WalkabilityGrid::AllDirections);
+			for (size_t i = 0; i < grid.GetCellCount(); ++i)
+			{
+				const uint32_t roll = random() % 100;
+				if (roll < 15) { grid.SetMask(grid.GetCell(i), 0); }
+				else if (roll < 20) { grid.SetMask(grid.GetCell(i), grid.GetMask(i) & ~(1u << (random() % 8))); }
+			}
+
+			const Vector2<int> start = grid.GetCell(random() % grid.GetCellCount());
+			const Vector2<int> goal = grid.GetCell(random() % grid.GetCellCount());
+			const bool isFound = pathfinder.AStar(grid, start, goal, aStarPath);
+			ASSERT_EQ(pathfinder.JumpPointSearch(grid, start, goal, jumpPointPath), isFound);
+			ASSERT_EQ(jumpPointPath.size(), aStarPath.size());
+			if (!isFound) { continue; }
+
+			// Every step must be a walkable move to a neighbour.
+			ASSERT_EQ(jumpPointPath.front(), start);
+			ASSERT_EQ(jumpPointPath.back(), goal);
+			for (size_t i = 1; i < jumpPointPath.size(); ++i)
+			{
+				const Vector2<int> step = jumpPointPath[i] - jumpPointPath[i - 1];
+				const size_t direction = std::find(WalkabilityGrid::Directions.begin(), WalkabilityGrid::Directions.end(), step) - WalkabilityGrid::Directions.begin();
+				ASSERT_LT(direction, WalkabilityGrid::Directions.size());
+				ASSERT_TRUE(grid.CanMove(jumpPointPath[i - 1], direction));
+			}
+		}
+	}
+
+	TEST(GridPathfinderTests, JumpPointSearchSkipsOpenGrid)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 64, 64 }, WalkabilityGrid::AllDirections);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+
+		ASSERT_TRUE(pathfinder.AStar(grid, { 1, 1 }, { 62, 40 }, path));
+		const size_t aStarExpanded = pathfinder.GetExpandedCount();
+		ASSERT_TRUE(pathfinder.JumpPointSearch(grid, { 1, 1 }, { 62, 40 }, path));
+		ASSERT_EQ(path.size(), 62);
+		ASSERT_LT(pathfinder.GetExpandedCount() * 10, aStarExpanded);
+	}
+
+	TEST(GridPathfinderTests, AvoidsCostlyTerrain)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 10, 10 }, WalkabilityGrid::AllDirections);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+
+		// A strip of mud across the way, apart from a gap at the bottom.
+		for (int y = 0; y < 8; ++y) { grid.SetCost({ 5, y }, 20); }
+		ASSERT_TRUE(pathfinder.AStar(grid, { 0, 0 }, { 9, 0 }, path));
+		for (const Vector2<int>& cell : path) { ASSERT_FALSE(cell.X == 5 && cell.Y < 8); }
+		ASSERT_EQ(path.size(), 17); // Down to the gap and back up, rather than 10 moves through the mud.
+
+		// Once going around costs more, it goes through.
+		for (int y = 0; y < 8; ++y) { grid.SetCost({ 5, y }, 3); }
+		ASSERT_TRUE(pathfinder.AStar(grid, { 0, 0 }, { 9, 0 }, path));
+		ASSERT_EQ(path.size(), 10);
+
+		// Jump point search can't skip over weighted cells, so finds the same path.
+		std::vector<Vector2<int>> jumpPath;
+		ASSERT_TRUE(pathfinder.JumpPointSearch(grid, { 0, 0 }, { 9, 0 }, jumpPath));
+		ASSERT_EQ(jumpPath, path);
+	}
+
+	TEST(GridPathfinderTests, FindsCheapestWeightedPath)
+	{
+		// Compare against an exhaustive search, as the heuristic has to stay admissible for A* to be right.
+		std::mt19937 random(99);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> path;
+
+		for (int test = 0; test < 20; ++test)
+		{
+			WalkabilityGrid grid;
+			grid.Resize({ 0, 0 }, { 16, 16 }, WalkabilityGrid::AllDirections);
+			for (size_t i = 0; i < grid.GetCellCount(); ++i)
+			{
+				grid.SetCost(grid.GetCell(i), static_cast<uint8_t>(1 + random() % 4));
+			}
+
+			const Vector2<int> start = grid.GetCell(random() % grid.GetCellCount());
+			const Vector2<int> goal = grid.GetCell(random() % grid.GetCellCount());
+
+			// Bellman-Ford style relaxation until nothing changes.
+			std::vector<int> costs(grid.GetCellCount(), std::numeric_limits<int>::max());
+			costs[grid.GetIndex(start)] = 0;
+			for (bool isChanged = true; isChanged;)
+			{
+				isChanged = false;
+				for (size_t i = 0; i < grid.GetCellCount(); ++i)
+				{
+					if (costs[i] == std::numeric_limits<int>::max()) { continue; }
+					for (const Vector2<int>& direction : WalkabilityGrid::Directions)
+					{
+						const Vector2<int> neighbour = grid.GetCell(i) + direction;
+						if (!grid.Contains(neighbour)) { continue; }
+
+						const size_t index = grid.GetIndex(neighbour);
+						if (costs[i] + grid.GetCost(index) < costs[index])
+						{
+							costs[index] = costs[i] + grid.GetCost(index);
+							isChanged = true;
+						}
+					}
+				}
+			}
+
+			ASSERT_TRUE(pathfinder.AStar(grid, start, goal, path));
+			int cost = 0;
+			for (size_t i = 1; i < path.size(); ++i) { cost += grid.GetCost(path[i]); }
+			ASSERT_EQ(cost, costs[grid.GetIndex(goal)]);
+		}
+	}
+}
@@ -0,0 +1,175 @@
+#include "../../Source/Pathfinding/HierarchicalGraph.h"
+#include "../../Source/Pathfinding/GridPathfinder.h"
+#include "../../Source/Pathfinding/WalkabilityGrid.h"
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	namespace
+	{
+		/// <summary>
+		/// Check the path runs from start to goal, with the refined part at the start made of walkable moves.
+		/// </summary>
+		void ExpectValidPath(const WalkabilityGrid& grid, const std::vector<Vector2<int>>& path, Vector2<int> start, Vector2<int> goal)
+		{
+			ASSERT_FALSE(path.empty());
+			ASSERT_EQ(path.front(), start);
+			ASSERT_EQ(path.back(), goal);
+			if (path.size() < 2) { return; }
+
+			const Vector2<int> step = path[1] - path[0];
+			const size_t direction = std::find(WalkabilityGrid::Directions.begin(), WalkabilityGrid::Directions.end(), step) - WalkabilityGrid::Directions.begin();
+			ASSERT_LT(direction, WalkabilityGrid::Directions.size());
+			ASSERT_TRUE(grid.CanMove(path[0], direction));
+		}
+	}
+
+	TEST(HierarchicalGraphTests, FindsPathAcrossClusters)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 64, 64 }, WalkabilityGrid::AllDirections);
+		HierarchicalGraph graph(8);
+		graph.Build(grid);
+		ASSERT_EQ(graph.GetClusterCount(), 64);
+		ASSERT_EQ(graph.GetRebuiltCount(), 64);
+
+		std::vector<Vector2<int>> path;
+		ASSERT_TRUE(graph.FindPath(grid, { 1, 1 }, { 60, 50 }, path));
+		ExpectValidPath(grid, path, { 1, 1 }, { 60, 50 });
+
+		// Within one cluster the path is fully refined.
+		ASSERT_TRUE(graph.FindPath(grid, { 1, 1 }, { 5, 3 }, path));
+		ASSERT_EQ(path.size(), 5);
+		ASSERT_TRUE(graph.FindPath(grid, { 4, 4 }, { 4, 4 }, path));
+		ASSERT_EQ(path.size(), 1);
+
+		ASSERT_FALSE(graph.FindPath(grid, { 1, 1 }, { 70, 0 }, path)); // Outside the grid.
+		ASSERT_TRUE(path.empty());
+	}
+
+	TEST(HierarchicalGraphTests, FindsPathsWhereAStarDoes)
+	{
+		std::mt19937 random(1234);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> aStarPath;
+		std::vector<Vector2<int>> path;
+
+		for (int test = 0; test < 50; ++test)
+		{
+			WalkabilityGrid grid;
+			grid.Resize({ 0, 0 }, { 40, 40 }, WalkabilityGrid::AllDirections);
+			for (size_t i = 0; i < grid.GetCellCount(); ++i)
+			{
+				if (random() % 100 < 25) { grid.BlockCell(grid.GetCell(i)); }
+			}
+
+			HierarchicalGraph graph(8);
+			graph.Build(grid);
+
+			const Vector2<int> start = grid.GetCell(random() % grid.GetCellCount());
+			const Vector2<int> goal = grid.GetCell(random() % grid.GetCellCount());
+			const bool isFound = pathfinder.AStar(grid, start, goal, aStarPath);
+			ASSERT_EQ(graph.FindPath(grid, start, goal, path), isFound);
+			if (isFound) { ExpectValidPath(grid, path, start, goal); }
+		}
+	}
+
+	TEST(HierarchicalGraphTests, SplitsEntrancesAtWallsBetweenCells)
+	{
+		// A wall between the two cells of the last row leaves them crossable from the row above, but not from each other.
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 2, 3 }, WalkabilityGrid::AllDirections);
+		grid.SetMask({ 0, 2 }, 0x7F);
+		grid.SetMask({ 1, 2 }, 0xBF);
+		HierarchicalGraph graph(2);
+		graph.Build(grid);
+
+		std::vector<Vector2<int>> path;
+		ASSERT_TRUE(graph.FindPath(grid, { 0, 0 }, { 1, 2 }, path));
+		ExpectValidPath(grid, path, { 0, 0 }, { 1, 2 });
+		ASSERT_TRUE(graph.FindPath(grid, { 1, 2 }, { 0, 2 }, path));
+		ExpectValidPath(grid, path, { 1, 2 }, { 0, 2 });
+	}
+
+	TEST(HierarchicalGraphTests, FindsPathsWhereAStarDoesWithWallsBetweenCells)
+	{
+		std::mt19937 random(5678);
+		GridPathfinder pathfinder;
+		std::vector<Vector2<int>> aStarPath;
+		std::vector<Vector2<int>> path;
+
+		for (int test = 0; test < 200; ++test)
+		{
+			// Walls between cells rather than on them, blocking each move they cross both ways.
+			WalkabilityGrid grid;
+			grid.Resize({ 0, 0 }, { 24, 24 }, WalkabilityGrid::AllDirections);
+			for (size_t i = 0; i < grid.GetCellCount(); ++i)
+			{
+				const Vector2<int> cell = grid.GetCell(i);
+				for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
+				{
+					const Vector2<int> neighbour = cell + WalkabilityGrid::Directions[direction];
+					if (!grid.Contains(neighbour) || grid.GetIndex(neighbour) < i || random() % 100 >= 40) { continue; }
+
+					const size_t back = WalkabilityGrid::GetDirectionIndex(-WalkabilityGrid::Directions[direction]);
+					grid.SetMask(cell, grid.GetMask(cell) & ~(1u << direction));
+					grid.SetMask(neighbour, grid.GetMask(neighbour) & ~(1u << back));
+				}
+			}
+
+			HierarchicalGraph graph(4);
+			graph.Build(grid);
+
+			for (int query = 0; query < 10; ++query)
+			{
+				const Vector2<int> start = grid.GetCell(random() % grid.GetCellCount());
+				const Vector2<int> goal = grid.GetCell(random() % grid.GetCellCount());
+				const bool isFound = pathfinder.AStar(grid, start, goal, aStarPath);
+				ASSERT_EQ(graph.FindPath(grid, start, goal, path), isFound);
+				if (isFound) { ExpectValidPath(grid, path, start, goal); }
+			}
+		}
+	}
+
+	TEST(HierarchicalGraphTests, RebuildsOnlyTouchedClusters)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 32, 32 }, WalkabilityGrid::AllDirections);
+		HierarchicalGraph graph(8);
+		graph.Build(grid);
+
+		// Blocking a cell changes the edges into it from its neighbours too.
+		auto blockCell = [&grid, &graph](Vector2<int> cell)
+		{
+			grid.BlockCell(cell);
+			for (int x = -1; x <= 1; ++x)
+			{
+				for (int y = -1; y <= 1; ++y) { graph.MarkChanged(cell + Vector2<int>{ x, y }); }
+			}
+		};
+
+		// Wall through the middle of the second column of clusters, leaving one gap.
+		for (int y = 0; y < 32; ++y)
+		{
+			if (y != 4) { blockCell({ 12, y }); }
+		}
+		graph.Update(grid);
+		ASSERT_EQ(graph.GetRebuiltCount(), 4);
+
+		std::vector<Vector2<int>> path;
+		ASSERT_TRUE(graph.FindPath(grid, { 2, 28 }, { 20, 28 }, path));
+		ExpectValidPath(grid, path, { 2, 28 }, { 20, 28 });
+
+		// Closing the gap only touches the cluster it's in, as it's away from the sides.
+		blockCell({ 12, 4 });
+		graph.Update(grid);
+		ASSERT_EQ(graph.GetRebuiltCount(), 1);
+		ASSERT_FALSE(graph.FindPath(grid, { 2, 28 }, { 20, 28 }, path));
+
+		// With nothing changed nothing is rebuilt.
+		graph.Update(grid);
+		ASSERT_EQ(graph.GetRebuiltCount(), 0);
+	}
+}
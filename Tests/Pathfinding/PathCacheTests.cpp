@@ -0,0 +1,56 @@
+#include "../../Source/Pathfinding/PathCache.h"
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	TEST(PathCacheTests, FindsInsertedPaths)
+	{
+		PathCache cache;
+		std::vector<Vector2<int>> path;
+		ASSERT_FALSE(cache.Find({ 0, 0 }, { 3, 0 }, 1, path).has_value());
+
+		cache.Insert({ 0, 0 }, { 3, 0 }, 1, { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 } });
+		cache.Insert({ 0, 0 }, { 9, 9 }, 1, {}); // No path.
+		ASSERT_EQ(cache.Find({ 0, 0 }, { 3, 0 }, 1, path), true);
+		ASSERT_EQ(path.size(), 4);
+		ASSERT_EQ(cache.Find({ 0, 0 }, { 9, 9 }, 1, path), false);
+		ASSERT_TRUE(path.empty());
+		ASSERT_EQ(cache.GetHitCount(), 2);
+		ASSERT_EQ(cache.GetMissCount(), 1);
+
+		// A newer version drops everything, and older searches can't add to it.
+		ASSERT_FALSE(cache.Find({ 0, 0 }, { 3, 0 }, 2, path).has_value());
+		ASSERT_EQ(cache.GetSize(), 0);
+		cache.Insert({ 0, 0 }, { 3, 0 }, 1, { { 0, 0 }, { 3, 0 } });
+		ASSERT_EQ(cache.GetSize(), 0);
+	}
+
+	TEST(PathCacheTests, ReusesRestOfPath)
+	{
+		PathCache cache;
+		std::vector<Vector2<int>> path;
+		cache.Insert({ 0, 0 }, { 3, 3 }, 0, { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 } });
+
+		ASSERT_EQ(cache.Find({ 2, 2 }, { 3, 3 }, 0, path), true);
+		ASSERT_EQ(path, (std::vector<Vector2<int>>{ { 2, 2 }, { 3, 3 } }));
+		ASSERT_EQ(cache.GetSize(), 2);
+
+		// Only for the same goal.
+		ASSERT_FALSE(cache.Find({ 1, 1 }, { 2, 2 }, 0, path).has_value());
+	}
+
+	TEST(PathCacheTests, EvictsLeastRecentlyUsed)
+	{
+		PathCache cache(2);
+		std::vector<Vector2<int>> path;
+		cache.Insert({ 0, 0 }, { 1, 0 }, 0, { { 0, 0 }, { 1, 0 } });
+		cache.Insert({ 0, 0 }, { 0, 1 }, 0, { { 0, 0 }, { 0, 1 } });
+		ASSERT_TRUE(cache.Find({ 0, 0 }, { 1, 0 }, 0, path).has_value());
+
+		cache.Insert({ 0, 0 }, { 1, 1 }, 0, { { 0, 0 }, { 1, 1 } });
+		ASSERT_EQ(cache.GetSize(), 2);
+		ASSERT_TRUE(cache.Find({ 0, 0 }, { 1, 0 }, 0, path).has_value());
+		ASSERT_FALSE(cache.Find({ 0, 0 }, { 0, 1 }, 0, path).has_value());
+		ASSERT_TRUE(cache.Find({ 0, 0 }, { 1, 1 }, 0, path).has_value());
+	}
+}
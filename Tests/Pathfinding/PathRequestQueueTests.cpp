@@ -0,0 +1,154 @@
+#include "../../Source/Pathfinding/PathRequestQueue.h"
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include <atomic>
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	namespace
+	{
+		/// <summary>
+		/// Solves every request with a straight path from start to goal, counting how many times it's called.
+		/// </summary>
+		PathRequestQueue::Solver CreateCountingSolver(std::atomic<int>& count)
+		{
+			return [&count](Vector2<int> start, Vector2<int> goal, std::vector<Vector2<int>>& path)
+			{
+				++count;
+				path = { start, goal };
+				return start != Vector2<int>{ -1, -1 };
+			};
+		}
+	}
+
+	TEST(PathRequestQueueTests, DeduplicatesRequests)
+	{
+		EntityManager entityManager;
+		ThreadPool pool;
+		pool.Start();
+
+		std::atomic<int> solveCount = 0;
+		PathRequestQueue queue(CreateCountingSolver(solveCount));
+		Entity first = entityManager.AddEntity("Agent");
+		Entity second = entityManager.AddEntity("Agent");
+		Entity third = entityManager.AddEntity("Agent");
+		Entity other = entityManager.AddEntity("Agent");
+		entityManager.Update();
+
+		queue.Request(first, { 0, 0 }, { 5, 5 });
+		queue.Request(second, { 0, 0 }, { 5, 5 });
+		queue.Request(third, { 0, 0 }, { 5, 5 });
+		queue.Request(other, { 1, 0 }, { 5, 5 });
+		ASSERT_EQ(queue.GetPendingCount(), 4);
+		ASSERT_EQ(queue.GetPath(first), nullptr);
+
+		queue.Process(pool, 7);
+		pool.Stop();
+		ASSERT_EQ(solveCount, 2);
+		ASSERT_EQ(queue.GetPendingCount(), 0);
+
+		for (Entity entity : { first, second, third })
+		{
+			PathRequestQueue::Path* path = queue.GetPath(entity);
+			ASSERT_NE(path, nullptr);
+			ASSERT_EQ(path->Goal, (Vector2<int>{ 5, 5 }));
+			ASSERT_EQ(path->Nodes.size(), 2);
+			ASSERT_EQ(path->Next, 1);
+			ASSERT_EQ(path->Version, 7);
+		}
+		ASSERT_EQ(queue.GetPath(other)->Nodes.front(), (Vector2<int>{ 1, 0 }));
+	}
+
+	TEST(PathRequestQueueTests, ReplacesAndDropsRequests)
+	{
+		EntityManager entityManager;
+		ThreadPool pool;
+		std::atomic<int> solveCount = 0;
+		PathRequestQueue queue(CreateCountingSolver(solveCount));
+		Entity replaced = entityManager.AddEntity("Agent");
+		Entity destroyed = entityManager.AddEntity("Agent");
+		Entity unreachable = entityManager.AddEntity("Agent");
+		entityManager.Update();
+
+		// Asking again before it's solved replaces the first request.
+		queue.Request(replaced, { 0, 0 }, { 5, 5 });
+		queue.Request(replaced, { 0, 0 }, { 3, 3 });
+		queue.Request(destroyed, { 0, 0 }, { 9, 9 });
+		queue.Request(unreachable, { -1, -1 }, { 9, 9 });
+		ASSERT_EQ(queue.GetPendingCount(), 3);
+
+		entityManager.Destroy(destroyed);
+		entityManager.Update();
+		queue.Process(pool, 0);
+		ASSERT_EQ(solveCount, 2);
+		ASSERT_EQ(queue.GetPath(replaced)->Goal, (Vector2<int>{ 3, 3 }));
+		ASSERT_EQ(queue.GetPath(destroyed), nullptr);
+
+		// Failed searches are still delivered, so the entity knows not to keep asking.
+		ASSERT_NE(queue.GetPath(unreachable), nullptr);
+		ASSERT_TRUE(queue.GetPath(unreachable)->Nodes.empty());
+	}
+
+	TEST(PathRequestQueueTests, SpreadsWorkOverBudget)
+	{
+		EntityManager entityManager;
+		ThreadPool pool;
+		pool.Start();
+
+		// With no budget only the oldest request is solved each time, the rest keep waiting in order.
+		std::atomic<int> solveCount = 0;
+		PathRequestQueue queue(CreateCountingSolver(solveCount), std::chrono::microseconds(0));
+		std::vector<Entity> entities;
+		for (int i = 0; i < 5; ++i)
+		{
+			entities.push_back(entityManager.AddEntity("Agent"));
+		}
+		entityManager.Update();
+		for (int i = 0; i < 5; ++i)
+		{
+			queue.Request(entities[i], { i, 0 }, { 10, 10 });
+		}
+
+		for (int i = 0; i < 5; ++i)
+		{
+			queue.Process(pool, 0);
+			ASSERT_EQ(queue.GetPendingCount(), 4 - i);
+			ASSERT_NE(queue.GetPath(entities[i]), nullptr);
+		}
+		pool.Stop();
+		ASSERT_EQ(solveCount, 5);
+	}
+
+	TEST(PathRequestQueueTests, BuildsFlowFieldForCrowds)
+	{
+		EntityManager entityManager;
+		ThreadPool pool;
+		std::atomic<int> solveCount = 0;
+		PathRequestQueue queue(CreateCountingSolver(solveCount));
+		std::vector<Vector2<int>> fieldGoals;
+		queue.SetFieldBuilder([&fieldGoals](Vector2<int> goal) { fieldGoals.push_back(goal); }, 3);
+
+		// Three entities from different starts share a goal, the last is alone.
+		std::vector<Entity> entities;
+		for (int i = 0; i < 4; ++i)
+		{
+			entities.push_back(entityManager.AddEntity("Agent"));
+		}
+		entityManager.Update();
+		for (int i = 0; i < 3; ++i)
+		{
+			queue.Request(entities[i], { i, 0 }, { 10, 10 });
+		}
+		queue.Request(entities[3], { 0, 0 }, { 20, 20 });
+
+		queue.Process(pool, 0);
+		ASSERT_EQ(fieldGoals, (std::vector<Vector2<int>>{ { 10, 10 } }));
+		ASSERT_EQ(solveCount, 1);
+		ASSERT_EQ(queue.GetPendingCount(), 0);
+		for (int i = 0; i < 3; ++i)
+		{
+			ASSERT_EQ(queue.GetPath(entities[i]), nullptr);
+		}
+		ASSERT_NE(queue.GetPath(entities[3]), nullptr);
+	}
+}
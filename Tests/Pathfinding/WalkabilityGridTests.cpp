@@ -0,0 +1,77 @@
+#include "../../Source/Pathfinding/WalkabilityGrid.h"
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	TEST(WalkabilityGridTests, CellsOutsideAreUnwalkable)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ -2, -3 }, { 5, 7 });
+		ASSERT_EQ(grid.GetCellCount(), 35);
+		ASSERT_EQ(grid.GetMask({ 0, 0 }), 0);
+
+		grid.SetMask({ -2, -3 }, WalkabilityGrid::AllDirections);
+		grid.SetMask({ 2, 3 }, 0b10);
+		grid.SetMask({ 3, 3 }, WalkabilityGrid::AllDirections); // Outside, so ignored.
+		ASSERT_EQ(grid.GetMask({ -2, -3 }), WalkabilityGrid::AllDirections);
+		ASSERT_TRUE(grid.CanMove({ 2, 3 }, 1));
+		ASSERT_FALSE(grid.CanMove({ 2, 3 }, 0));
+		ASSERT_FALSE(grid.Contains({ 3, 3 }));
+		ASSERT_EQ(grid.GetMask({ 3, 3 }), 0);
+	}
+
+	TEST(WalkabilityGridTests, BlockedFromBothSides)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 3, 3 }, WalkabilityGrid::AllDirections);
+		ASSERT_EQ(grid.GetMask({ 2, 2 }), WalkabilityGrid::AllDirections);
+
+		grid.BlockCell({ 1, 1 });
+		grid.BlockCell({ 3, 3 }); // Outside, so only its neighbours inside are changed.
+		ASSERT_EQ(grid.GetMask({ 1, 1 }), 0);
+		for (size_t direction = 0; direction < WalkabilityGrid::Directions.size(); ++direction)
+		{
+			const Vector2<int> neighbour = Vector2<int>{ 1, 1 } + WalkabilityGrid::Directions[direction];
+			const size_t back = WalkabilityGrid::GetDirectionIndex(-WalkabilityGrid::Directions[direction]);
+			ASSERT_FALSE(grid.CanMove(neighbour, back));
+		}
+
+		// Only the moves into blocked cells are removed.
+		ASSERT_EQ(grid.GetMask({ 0, 0 }), WalkabilityGrid::AllDirections & ~(1u << WalkabilityGrid::GetDirectionIndex({ 1, 1 })));
+		ASSERT_EQ(grid.GetMask({ 2, 2 }), WalkabilityGrid::AllDirections & ~(1u << WalkabilityGrid::GetDirectionIndex({ 1, 1 })) & ~(1u << WalkabilityGrid::GetDirectionIndex({ -1, -1 })));
+	}
+
+	TEST(WalkabilityGridTests, IndexRoundTrip)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ -4, 2 }, { 6, 3 });
+		for (size_t i = 0; i < grid.GetCellCount(); ++i)
+		{
+			ASSERT_EQ(grid.GetIndex(grid.GetCell(i)), i);
+		}
+	}
+
+	TEST(WalkabilityGridTests, TracksWeightedCells)
+	{
+		WalkabilityGrid grid;
+		grid.Resize({ 0, 0 }, { 4, 4 });
+		ASSERT_EQ(grid.GetCost({ 1, 1 }), WalkabilityGrid::DefaultCost);
+		ASSERT_TRUE(grid.IsUniformCost());
+
+		grid.SetCost({ 1, 1 }, 5);
+		grid.SetCost({ 2, 1 }, 3);
+		grid.SetCost({ 9, 9 }, 7); // Outside, so ignored.
+		ASSERT_EQ(grid.GetCost({ 1, 1 }), 5);
+		ASSERT_EQ(grid.GetCost(grid.GetIndex({ 2, 1 })), 3);
+		ASSERT_FALSE(grid.IsUniformCost());
+
+		grid.SetCost({ 1, 1 }, 0); // Raised to the default.
+		ASSERT_EQ(grid.GetCost({ 1, 1 }), WalkabilityGrid::DefaultCost);
+		grid.SetCost({ 2, 1 }, WalkabilityGrid::DefaultCost);
+		ASSERT_TRUE(grid.IsUniformCost());
+
+		grid.SetCost({ 3, 3 }, 2);
+		grid.Resize({ 0, 0 }, { 4, 4 });
+		ASSERT_TRUE(grid.IsUniformCost());
+	}
+}
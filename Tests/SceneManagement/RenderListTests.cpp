@@ -0,0 +1,211 @@
+#include "../../Source/SceneManagement/RenderList.h"
+#include "../../Source/SceneManagement/DepthKey.h"
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include "../../Source/EntityComponentSystem/Components.h"
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	namespace
+	{
+		Entity AddSprite(EntityManager& entityManager, float x, float y, int z = 0)
+		{
+			Entity entity = entityManager.AddEntity("Rendered");
+			entity.AddComponent<Position>() = { { x, y }, z };
+			entity.AddComponent<Sprite>();
+			return entity;
+		}
+
+		std::vector<Entity> GetOrder(const RenderList& list)
+		{
+			std::vector<Entity> entities;
+			for (const RenderList::Item& item : list.GetItems()) { entities.push_back(item.Owner); }
+			return entities;
+		}
+	}
+
+	TEST(RenderListTests, DepthKeysCompareByZThenY)
+	{
+		ASSERT_LT(DepthKey::Pack(-1, 100.f, 9), DepthKey::Pack(0, -100.f, 0));
+		ASSERT_LT(DepthKey::Pack(0, -100.f, 9), DepthKey::Pack(0, -0.5f, 0));
+		ASSERT_LT(DepthKey::Pack(0, -0.5f, 9), DepthKey::Pack(0, 0.f, 0));
+		ASSERT_LT(DepthKey::Pack(0, 0.5f, 0), DepthKey::Pack(0, 0.5f, 1));
+		ASSERT_EQ(DepthKey::Pack(0, -0.f, 0), DepthKey::Pack(0, 0.f, 0));
+		ASSERT_EQ(DepthKey::GetIndex(DepthKey::Pack(DepthKey::MinZ, -1.f, DepthKey::MaxIndex)), DepthKey::MaxIndex);
+		ASSERT_FALSE(DepthKey::CanPack(DepthKey::MaxZ + 1, 0));
+	}
+
+	TEST(RenderListTests, SortsByZThenY)
+	{
+		EntityManager entityManager;
+		RenderList list;
+		Entity raised = AddSprite(entityManager, 0, 0, 1);
+		Entity lower = AddSprite(entityManager, 0, 20);
+		Entity upper = AddSprite(entityManager, 0, 10);
+		entityManager.AddEntity("Unrendered").AddComponent<Position>();
+		entityManager.Update();
+		list.Update(entityManager);
+
+		ASSERT_EQ(GetOrder(list), (std::vector<Entity>{ upper, lower, raised }));
+	}
+
+	//          0         1         2         3         4
+	//	  Y:Z{ 1,0 }, { 2,1 }, { 0, 0 }, { 1, 1 }, { 0, 2 }
+	//          2         0         3         1         4
+	// output{ 0,0 }, { 1,0 }, {1, 1},   {2, 1},   {0, 2}
+	TEST(RenderListTests, ZSorting)
+	{
+		const std::vector<Position> input = { {{-64, 32}, 0 }, {{-128, 64}, 1}, {{0, 0}, 0}, {{-64, 32}, 1}, {{0, 0}, 2} };
+		const std::vector<size_t> output = { 2, 0, 3, 1, 4 };
+
+		EntityManager entityManager;
+		RenderList list;
+		std::vector<Entity> entities;
+		for (const Position& position : input) { entities.push_back(AddSprite(entityManager, position.X, position.Y, position.Z)); }
+		entityManager.Update();
+		list.Update(entityManager);
+
+		const std::vector<Entity> order = GetOrder(list);
+		ASSERT_EQ(order.size(), output.size());
+		for (size_t i = 0; i < output.size(); i++)
+		{
+			ASSERT_EQ(order[i], entities[output[i]]);
+		}
+	}
+
+	TEST(RenderListTests, YSorting)
+	{
+		// Higher up the screen is behind, whichever side it's on.
+		EntityManager entityManager;
+		RenderList list;
+		Entity lower = AddSprite(entityManager, 0, 64);
+		Entity upperRight = AddSprite(entityManager, 64, 32);
+		Entity upperLeft = AddSprite(entityManager, -64, 16);
+		entityManager.Update();
+		list.Update(entityManager);
+
+		ASSERT_EQ(GetOrder(list), (std::vector<Entity>{ upperLeft, upperRight, lower }));
+	}
+
+	TEST(RenderListTests, TracksChanges)
+	{
+		EntityManager entityManager;
+		RenderList list;
+		std::vector<Entity> entities;
+		for (int i = 0; i < 64; ++i) { entities.push_back(AddSprite(entityManager, 0, static_cast<float>(i))); }
+		entityManager.Update();
+		list.Update(entityManager);
+
+		// Few enough changes to be moved into place rather than sorted again.
+		entities[0].GetComponent<Position>().Y = 100;
+		entities[63].GetComponent<Position>().Y = -1;
+		entityManager.Destroy(entities[10]);
+		entities[11].RemoveComponent<Sprite>();
+		Entity added = AddSprite(entityManager, 0, 15.5f);
+		entityManager.Update();
+		list.Update(entityManager);
+
+		std::vector<Entity> order = GetOrder(list);
+		ASSERT_EQ(order.size(), 63);
+		ASSERT_EQ(order.front(), entities[63]);
+		ASSERT_EQ(order.back(), entities[0]);
+		ASSERT_EQ(order[14], added);
+		for (size_t i = 1; i < list.GetItems().size(); ++i)
+		{
+			ASSERT_TRUE(list.GetItems()[i - 1].IsBefore(list.GetItems()[i]));
+		}
+
+		// Only moving sideways keeps the order but still updates the position used for culling.
+		entities[5].GetComponent<Position>().X = 50;
+		entityManager.Update();
+		list.Update(entityManager);
+		size_t culledCount = 0;
+		list.ForEachInArea({ 40, -10, 20, 20 }, [&](const RenderList::Item& item)
+		{
+			ASSERT_EQ(item.Owner, entities[5]);
+			++culledCount;
+		});
+		ASSERT_EQ(culledCount, 1);
+	}
+
+	TEST(RenderListTests, StaticItemsKeptApart)
+	{
+		EntityManager entityManager;
+		RenderList list(Tags::TileSet);
+		std::vector<Entity> tiles;
+		for (int i = 0; i < 4; ++i)
+		{
+			Entity tile = entityManager.AddEntity(Tags::TileSet);
+			tile.AddComponent<Position>() = { { 0, static_cast<float>(3 - i) }, 0 };
+			tile.AddComponent<Sprite>();
+			tiles.push_back(tile);
+		}
+		Entity npc = AddSprite(entityManager, 0, 1.5f);
+		entityManager.Update();
+		list.Update(entityManager);
+
+		// Culling only sees what isn't static, while tiles are still in draw order for baking.
+		ASSERT_EQ(GetOrder(list), (std::vector<Entity>{ npc }));
+		ASSERT_EQ(list.GetStaticItems().size(), 4);
+		ASSERT_EQ(list.GetStaticItems().front().Owner, tiles[3]);
+		ASSERT_EQ(list.GetStaticItems().back().Owner, tiles[0]);
+		ASSERT_FALSE(list.GetStaticChanges().empty());
+		size_t culledCount = 0;
+		list.ForEachInArea({ -10, -10, 20, 20 }, [&](const RenderList::Item&) { ++culledCount; });
+		ASSERT_EQ(culledCount, 1);
+
+		// Moving and removing dynamic entities leaves the tiles alone.
+		npc.GetComponent<Position>().Y = 5;
+		AddSprite(entityManager, 0, 2);
+		entityManager.Update();
+		list.Update(entityManager);
+		entityManager.Destroy(npc);
+		entityManager.Update();
+		list.Update(entityManager);
+		ASSERT_EQ(list.GetItems().size(), 1);
+		ASSERT_EQ(list.GetStaticItems().size(), 4);
+		ASSERT_TRUE(list.GetStaticChanges().empty());
+
+		// A tile's ID reused by a dynamic entity moves it between lists.
+		entityManager.Destroy(tiles[1]);
+		entityManager.Update();
+		Entity reused = AddSprite(entityManager, 0, 0);
+		ASSERT_EQ(reused.GetID(), tiles[1].GetID());
+		entityManager.Update();
+		list.Update(entityManager);
+		ASSERT_EQ(list.GetItems().size(), 2);
+		ASSERT_EQ(list.GetItems().front().Owner, reused);
+		ASSERT_EQ(list.GetStaticItems().size(), 3);
+		ASSERT_EQ(list.GetStaticChanges().size(), 1);
+		for (const RenderList::Item& item : list.GetStaticItems()) { ASSERT_NE(item.Owner, reused); }
+	}
+
+	TEST(RenderListTests, TilesWithCollidersKeptSorted)
+	{
+		EntityManager entityManager;
+		RenderList list(Tags::TileSet);
+		Entity floor = entityManager.AddEntity(Tags::TileSet);
+		floor.AddComponent<Position>() = { { 0, 0 }, 0 };
+		floor.AddComponent<Sprite>();
+		Entity wall = entityManager.AddEntity(Tags::TileSet);
+		wall.AddComponent<Position>() = { { 0, 2 }, 0 };
+		wall.AddComponent<Sprite>();
+		wall.AddComponent<Collider>();
+		Entity npc = AddSprite(entityManager, 0, 1);
+		entityManager.Update();
+		list.Update(entityManager);
+
+		// Walls can be in front of or behind what moves around them, so are sorted with it rather than baked.
+		ASSERT_EQ(GetOrder(list), (std::vector<Entity>{ npc, wall }));
+		ASSERT_EQ(list.GetStaticItems().size(), 1);
+		ASSERT_EQ(list.GetStaticItems().front().Owner, floor);
+
+		// Gaining a collider moves a tile out of the static items.
+		floor.AddComponent<Collider>();
+		entityManager.Update();
+		list.Update(entityManager);
+		ASSERT_EQ(GetOrder(list), (std::vector<Entity>{ floor, npc, wall }));
+		ASSERT_TRUE(list.GetStaticItems().empty());
+		ASSERT_FALSE(list.GetStaticChanges().empty());
+	}
+}
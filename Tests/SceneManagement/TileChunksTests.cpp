@@ -0,0 +1,81 @@
+#include "../../Source/SceneManagement/TileChunks.h"
+#include "../../Source/SceneManagement/RenderList.h"
+#include "../../Source/Commands/CreateEntityCommand.h"
+#include "../../Source/Commands/DeleteEntityCommand.h"
+#include "../../Source/Commands/UndoManager.h"
+#include "../../Source/EntityComponentSystem/EntityManager.h"
+#include "../../Source/EntityComponentSystem/Components.h"
+#include "../../Source/EntityComponentSystem/TupleHelper.h"
+#include <gtest/gtest.h>
+
+namespace Engine
+{
+	TEST(TileChunksTests, OrderedForDrawing)
+	{
+		TileChunks chunks(100);
+		ASSERT_LT(chunks.GetKey(0, { 500, 500 }), chunks.GetKey(1, { 0, 0 }));
+		ASSERT_LT(chunks.GetKey(0, { 150, 0 }), chunks.GetKey(0, { 0, 150 }));
+		ASSERT_LT(chunks.GetKey(0, { 0, 0 }), chunks.GetKey(0, { 150, 0 }));
+		ASSERT_EQ(chunks.GetKey(0, { 0, 0 }), chunks.GetKey(0, { 99, 99 }));
+
+		const TileChunks::ChunkKey negative = chunks.GetKey(0, { -1, -150 });
+		ASSERT_EQ(negative.Column, -1);
+		ASSERT_EQ(negative.Row, -2);
+		ASSERT_EQ(chunks.GetArea(negative).Position, (Vector2<float>{ -100, -200 }));
+	}
+
+	TEST(TileChunksTests, InvalidatedByTileCommands)
+	{
+		UndoManager undoManager;
+		EntityManager entityManager;
+		RenderList renderList(Tags::TileSet);
+		TileChunks chunks(100);
+		auto update = [&]()
+		{
+			entityManager.Update();
+			renderList.Update(entityManager);
+			chunks.Update(renderList);
+		};
+		auto markBaked = [&]()
+		{
+			for (auto& [key, chunk] : chunks.GetChunks()) { chunk.IsDirty = false; }
+		};
+
+		ComponentSlice components = {};
+		std::bitset<64> enabledComponents;
+		enabledComponents[tuple_element_index_v<Position, ComponentSlice>] = true;
+		enabledComponents[tuple_element_index_v<Sprite, ComponentSlice>] = true;
+		std::get<Position>(components) = { { 50, 50 }, 0 };
+		undoManager.AddCommandAndExecute<CreateEntityCommand>(components, enabledComponents, entityManager);
+		std::get<Position>(components) = { { 250, 50 }, 0 };
+		undoManager.AddCommandAndExecute<CreateEntityCommand>(components, enabledComponents, entityManager);
+
+		// Sprites that aren't tiles are drawn on their own.
+		Entity npc = entityManager.AddEntity(Tags::TestNPC);
+		npc.AddComponent<Position>() = { { 450, 50 }, 0 };
+		npc.AddComponent<Sprite>();
+		update();
+
+		const TileChunks::ChunkKey deletedKey = chunks.GetKey(0, { 50, 50 });
+		const TileChunks::ChunkKey keptKey = chunks.GetKey(0, { 250, 50 });
+		ASSERT_EQ(chunks.size(), 2);
+		ASSERT_TRUE(chunks.GetChunks().at(deletedKey).IsDirty);
+		ASSERT_TRUE(chunks.GetChunks().at(keptKey).IsDirty);
+		markBaked();
+
+		// Only the chunk the tile was deleted from needs baking again, however much else moves.
+		std::vector<Entity>& tiles = entityManager.GetEntitiesByTag(Tags::TileSet);
+		Entity deleted = tiles[0].ReadComponent<Position>().X == 50 ? tiles[0] : tiles[1];
+		undoManager.AddCommandAndExecute<DeleteEntityCommand>(deleted, entityManager);
+		npc.GetComponent<Position>().X = 60;
+		update();
+		ASSERT_TRUE(chunks.GetChunks().at(deletedKey).IsDirty);
+		ASSERT_FALSE(chunks.GetChunks().at(keptKey).IsDirty);
+
+		markBaked();
+		undoManager.Undo();
+		update();
+		ASSERT_TRUE(chunks.GetChunks().at(deletedKey).IsDirty);
+		ASSERT_FALSE(chunks.GetChunks().at(keptKey).IsDirty);
+	}
+}